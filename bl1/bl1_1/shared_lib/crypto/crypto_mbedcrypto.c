@@ -364,6 +364,18 @@ fih_int bl1_hash_update(const uint8_t *data,
     FIH_RET(fih_rc);
 }
 
+fih_int bl1_hash_update_and_copy(const uint8_t *data,
+                                 size_t data_length,
+                                 uint8_t *out)
+{
+    fih_int fih_rc;
+
+    memcpy(out, data, data_length);
+    FIH_CALL(bl1_hash_update, fih_rc, out, data_length);
+
+    FIH_RET(fih_rc);
+}
+
 fih_int bl1_hash_compute(enum tfm_bl1_hash_alg_t alg,
                          const uint8_t *data,
                          size_t data_length,
@@ -101,6 +101,21 @@ fih_int bl1_hash_init(enum tfm_bl1_hash_alg_t alg);
  */
 fih_int bl1_hash_update(const uint8_t *data,
                         size_t data_length);
+/**
+ * @brief Updates an ongoing multipart hashing operation with some input data,
+ *        and copies the input data to an output buffer. Backends which can
+ *        hash the data while it is copied only read the input once.
+ *
+ * @param[in]  data        Buffer containing the input bytes
+ * @param[in]  data_length Size in bytes of the input \p data buffer
+ * @param[out] out         Buffer the input bytes are copied to. Must be at
+ *                         least \p data_length bytes and not overlap \p data
+ *
+ * @return fih_int 0 on success, non-zero on error
+ */
+fih_int bl1_hash_update_and_copy(const uint8_t *data,
+                                 size_t data_length,
+                                 uint8_t *out);
 /**
  * @brief Finalises an ongoing multipart hashing operation
  *
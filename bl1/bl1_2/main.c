@@ -30,6 +30,19 @@ enum boot_measurement_slot_t {
 };
 #endif
 
+/* Fusing the copy with the hash is only possible when the image is read
+ * directly from flash and is not encrypted, as otherwise the measurement is
+ * over the decrypted image.
+ */
+#if defined(TFM_BL1_2_COPY_AND_HASH) && defined(TFM_BL1_MEMORY_MAPPED_FLASH) && \
+    !defined(TFM_BL1_2_IMAGE_ENCRYPTION)
+#define BL1_2_COPY_AND_HASH
+#endif
+
+/* Measurement of the BL2 image being validated */
+static uint8_t image_measurement[TFM_BL1_2_MEASUREMENT_HASH_MAX_SIZE];
+static size_t image_measurement_size;
+
 #if defined(TEST_BL1_1) && defined(PLATFORM_DEFAULT_BL1_TEST_EXECUTION)
 #include "bl1_2_suites.h"
 #endif /* defined(TEST_BL1_1) && defined(PLATFORM_DEFAULT_BL1_TEST_EXECUTION) */
@@ -261,28 +274,17 @@ static fih_int check_key_policy(fih_int validate_rc,
 }
 #endif
 
-static fih_int is_image_signature_valid(struct bl1_2_image_t *img)
+static fih_int is_image_signature_valid(struct bl1_2_image_t *img,
+                                        uint8_t *measurement_hash,
+                                        size_t measurement_hash_size)
 {
     fih_int fih_rc = FIH_FAILURE;
-    static uint8_t measurement_hash[TFM_BL1_2_MEASUREMENT_HASH_MAX_SIZE];
-    static size_t measurement_hash_size;
     uint32_t idx;
 #ifdef TFM_BL1_2_ENABLE_ROTPK_POLICIES
     bool key_must_sign  = true;
     bool key_might_sign = false;
 #endif
 
-    /* Calculate the image hash for measured boot */
-    FIH_CALL(bl1_hash_compute, fih_rc, TFM_BL1_2_MEASUREMENT_HASH_ALG,
-                                       (uint8_t *)&img->protected_values,
-                                       sizeof(img->protected_values),
-                                       measurement_hash, sizeof(measurement_hash),
-                                       &measurement_hash_size);
-    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
-        ERROR("Boot measurement failed\n");
-        FIH_RET(fih_rc);
-    }
-
     for (idx = 0; idx < TFM_BL1_2_SIGNER_AMOUNT; idx++) {
         FIH_CALL(validate_image_signature, fih_rc, img,
                                                    &img->header.sigs[idx],
@@ -306,14 +308,15 @@ static fih_int is_image_signature_valid(struct bl1_2_image_t *img)
     FIH_RET(FIH_SUCCESS);
 }
 
-#ifndef TEST_BL1_2
-static
-#endif
-fih_int bl1_2_validate_image_at_addr(struct bl1_2_image_t *image)
+static fih_int validate_image_with_measurement(struct bl1_2_image_t *image,
+                                               uint8_t *measurement_hash,
+                                               size_t measurement_hash_size)
 {
     fih_int fih_rc = FIH_FAILURE;
 
-    FIH_CALL(is_image_signature_valid, fih_rc, image);
+    FIH_CALL(is_image_signature_valid, fih_rc, image,
+                                               measurement_hash,
+                                               measurement_hash_size);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         ERROR("BL2 image signature failed to validate\n");
         FIH_RET(fih_rc);
@@ -328,6 +331,30 @@ fih_int bl1_2_validate_image_at_addr(struct bl1_2_image_t *image)
     FIH_RET(FIH_SUCCESS);
 }
 
+#ifndef TEST_BL1_2
+static
+#endif
+fih_int bl1_2_validate_image_at_addr(struct bl1_2_image_t *image)
+{
+    fih_int fih_rc = FIH_FAILURE;
+
+    /* Calculate the image hash for measured boot */
+    FIH_CALL(bl1_hash_compute, fih_rc, TFM_BL1_2_MEASUREMENT_HASH_ALG,
+                                       (uint8_t *)&image->protected_values,
+                                       sizeof(image->protected_values),
+                                       image_measurement, sizeof(image_measurement),
+                                       &image_measurement_size);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        ERROR("Boot measurement failed\n");
+        FIH_RET(fih_rc);
+    }
+
+    FIH_CALL(validate_image_with_measurement, fih_rc, image,
+                                                      image_measurement,
+                                                      image_measurement_size);
+    FIH_RET(fih_rc);
+}
+
 #ifdef TFM_BL1_2_IMAGE_ENCRYPTION
 #ifndef TEST_BL1_2
 static
@@ -398,6 +425,46 @@ fih_int copy_and_decrypt_image(uint32_t image_id, struct bl1_2_image_t *image)
     FIH_RET(FIH_SUCCESS);
 }
 
+#elif defined(BL1_2_COPY_AND_HASH)
+
+/* Copies the image from memory-mapped flash into SRAM and computes the
+ * measurement hash in the same pass, through bl1_hash_update_and_copy(), so
+ * that the image is only read from flash once. The bytes which are hashed are
+ * the bytes which are written to SRAM, so a later modification of the flash
+ * contents cannot cause a mismatch between what was measured and what is run.
+ */
+static fih_int copy_and_hash_image(uint32_t image_id,
+                                   struct bl1_2_image_t *image,
+                                   uint8_t *hash,
+                                   size_t hash_length,
+                                   size_t *hash_size)
+{
+    const struct bl1_2_image_t *image_to_copy;
+    fih_int fih_rc = FIH_FAILURE;
+
+    image_to_copy = (struct bl1_2_image_t *)(FLASH_BL1_BASE_ADDRESS +
+                       bl1_image_get_flash_offset(image_id));
+
+    /* Snapshot the header, which isn't part of the measurement */
+    memcpy(image, image_to_copy, offsetof(struct bl1_2_image_t, protected_values));
+
+    FIH_CALL(bl1_hash_init, fih_rc, TFM_BL1_2_MEASUREMENT_HASH_ALG);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        FIH_RET(fih_rc);
+    }
+
+    FIH_CALL(bl1_hash_update_and_copy, fih_rc,
+             (const uint8_t *)&image_to_copy->protected_values,
+             sizeof(image->protected_values),
+             (uint8_t *)&image->protected_values);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        FIH_RET(fih_rc);
+    }
+
+    FIH_CALL(bl1_hash_finish, fih_rc, hash, hash_length, hash_size);
+    FIH_RET(fih_rc);
+}
+
 #else /* TFM_BL1_2_IMAGE_ENCRYPTION */
 
 fih_int copy_image(uint32_t image_id, struct bl1_2_image_t *image)
@@ -433,6 +500,17 @@ static fih_int bl1_2_validate_image(uint32_t image_id)
     }
 
     INFO("BL2 image decrypted successfully\n");
+#elif defined(BL1_2_COPY_AND_HASH)
+    FIH_CALL(copy_and_hash_image, fih_rc, image_id, image,
+                                          image_measurement,
+                                          sizeof(image_measurement),
+                                          &image_measurement_size);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        ERROR("BL2 image failed to copy\n");
+        FIH_RET(fih_rc);
+    }
+
+    INFO("BL2 image copied and measured successfully\n");
 #else
     FIH_CALL(copy_image, fih_rc, image_id, image);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
@@ -443,7 +521,13 @@ static fih_int bl1_2_validate_image(uint32_t image_id)
     INFO("BL2 image copied successfully\n");
 #endif
 
+#ifdef BL1_2_COPY_AND_HASH
+    FIH_CALL(validate_image_with_measurement, fih_rc, image,
+                                                      image_measurement,
+                                                      image_measurement_size);
+#else
     FIH_CALL(bl1_2_validate_image_at_addr, fih_rc, image);
+#endif
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         ERROR("BL2 image failed to validate\n");
         FIH_RET(fih_rc);
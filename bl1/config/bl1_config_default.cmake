@@ -63,6 +63,7 @@ set(TFM_BL1_2_EMBED_ROTPK_IN_IMAGE      OFF         CACHE STRING    "Whether to
 set(TFM_BL1_2_IMAGE_ENCRYPTION          ON          CACHE STRING    "Whether to encrypt images loaded by BL1_2")
 set(TFM_BL1_2_SIGNER_AMOUNT             1           CACHE STRING    "Maximum amount of possible signatures on BL1_2 image")
 set(TFM_BL1_2_ENABLE_ROTPK_POLICIES     OFF         CACHE STRING    "Whether to allow individual key signing policies for BL1_2 image")
+set(TFM_BL1_2_COPY_AND_HASH             OFF         CACHE STRING    "Whether to measure an unencrypted BL2 image while copying it from memory-mapped flash")
 
 if (TFM_BL1_2_EMBED_ROTPK_IN_IMAGE)
     set(TFM_BL1_2_ROTPK_HASH_ALG       SHA256      CACHE STRING "Algorithm to use for ROTPK comparision")
@@ -78,6 +78,7 @@ if (TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
                         ${INTERFACE_INC_DIR}/psa/storage_common.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR}/psa)
     install(FILES       ${INTERFACE_INC_DIR}/tfm_its_defs.h
+                        ${INTERFACE_INC_DIR}/tfm_its_api.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR})
 endif()
 
@@ -107,6 +108,7 @@ if (TFM_PARTITION_CRYPTO)
                         ${INTERFACE_INC_DIR}/psa/crypto_values.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR}/psa)
     install(FILES       ${INTERFACE_INC_DIR}/tfm_crypto_defs.h
+                        ${INTERFACE_INC_DIR}/tfm_crypto_batch.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR})
     install(DIRECTORY   ${INTERFACE_INC_DIR}/mbedtls
             DESTINATION ${INSTALL_INTERFACE_INC_DIR})
@@ -65,6 +65,7 @@ set(NS_EVALUATION_APP_PATH              ""          CACHE PATH      "Path to TFM
 
 set(TFM_ISOLATION_LEVEL                 1           CACHE STRING    "Isolation level")
 set(PSA_FRAMEWORK_HAS_MM_IOVEC          OFF         CACHE BOOL      "Enable MM-IOVEC")
+set(CONFIG_TFM_PSA_MAX_IOVEC            4           CACHE STRING    "Maximum total number of input plus output vectors of a psa_call(), up to 31")
 set(TFM_PROFILE                         ""          CACHE STRING    "Profile to use")
 set(TFM_FIH_PROFILE                     OFF         CACHE STRING    "Fault injection hardening profile [OFF, LOW, MEDIUM, HIGH]")
 set(CONFIG_TFM_SPM_BACKEND              "SFN"       CACHE STRING    "The SPM backend [IPC, SFN]")
@@ -93,6 +94,7 @@ set(CONFIG_TFM_HALT_ON_CORE_PANIC       OFF         CACHE BOOL       "On fatal e
 set(CONFIG_TFM_BACKTRACE_ON_CORE_PANIC  OFF         CACHE BOOL       "On fatal errors in secure firmware, log backtrace and then halt")
 
 set(CONFIG_TFM_STACK_WATERMARKS         OFF         CACHE BOOL      "Whether to pre-fill partition stacks with a set value to help determine stack usage")
+set(CONFIG_TFM_SPM_DMA_IOVEC_COPY       OFF         CACHE BOOL      "Whether psa_read() and psa_write() share large copies between the CPU and the platform DMA copy HAL")
 
 set(CONFIG_TFM_BRANCH_PROTECTION_FEAT   BRANCH_PROTECTION_DISABLED   CACHE STRING    "Set default branch protection usage to disabled")
 
@@ -125,6 +127,7 @@ set(PLATFORM_DEFAULT_OTP                ON          CACHE BOOL      "Use trusted
 set(PLATFORM_DEFAULT_OTP_WRITEABLE      ON          CACHE BOOL      "Use OTP memory with write support")
 set(PLATFORM_DEFAULT_PROVISIONING       ON          CACHE BOOL      "Use default provisioning implementation")
 set(PLATFORM_DEFAULT_SYSTEM_RESET_HALT  ON          CACHE BOOL      "Use default system reset/halt implementation")
+set(PLATFORM_DEFAULT_DMA_COPY           ON          CACHE BOOL      "Use the CPU stand-in for the DMA copy HAL")
 set(PLATFORM_DEFAULT_IMAGE_SIGNING      ON          CACHE BOOL      "Use default image signing implementation")
 set(PLATFORM_DEFAULT_PROV_LINKER_SCRIPT ON          CACHE BOOL      "Use default provisioning linker script")
 
@@ -146,6 +149,7 @@ set(ITS_ENCRYPTION                   OFF         CACHE BOOL      "Enable authent
 
 set(TFM_PARTITION_CRYPTO                OFF         CACHE BOOL      "Enable Crypto partition")
 set(CRYPTO_TFM_BUILTIN_KEYS_DRIVER      ON          CACHE BOOL      "Whether to allow crypto service to store builtin keys. Without this, ALL builtin keys must be stored in a platform-specific location")
+set(CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE   OFF         CACHE BOOL      "Whether the builtin key loader derives the per-user subkeys of builtin keys at Crypto service init, rather than on first use. Requires TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0")
 
 set(TFM_PARTITION_INITIAL_ATTESTATION   OFF         CACHE BOOL      "Enable Initial Attestation partition")
 set(SYMMETRIC_INITIAL_ATTESTATION       OFF         CACHE BOOL      "Use symmetric crypto for inital attestation")
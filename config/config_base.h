@@ -35,6 +35,11 @@
 #define PLATFORM_NV_COUNTER_MODULE_DISABLED    0
 #endif
 
+/* Cache the NV counter values read through the platform service in RAM */
+#ifndef PLATFORM_NV_COUNTER_CACHE
+#define PLATFORM_NV_COUNTER_CACHE              0
+#endif
+
 /* Crypto Partition Configs */
 
 /*
@@ -56,6 +61,44 @@
 #define CRYPTO_RNG_MODULE_ENABLED              1
 #endif
 
+/*
+ * Size in bytes of the pool of pre-generated random output used to serve small
+ * random requests. 0 disables the pool.
+ */
+#ifndef CRYPTO_RNG_POOL_SIZE
+#define CRYPTO_RNG_POOL_SIZE                   0
+#endif
+
+/*
+ * Number of persistent keys whose use is tracked to keep the most frequently
+ * used ones loaded in the PSA core key slots. 0 disables the tracking.
+ */
+#ifndef CRYPTO_KEY_RESIDENCY_TRACKED_KEYS
+#define CRYPTO_KEY_RESIDENCY_TRACKED_KEYS      0
+#endif
+
+/*
+ * Number of PSA core key slots kept free ahead of each request using a key,
+ * by purging the least frequently used tracked persistent keys.
+ */
+#ifndef CRYPTO_KEY_RESIDENCY_FREE_SLOTS
+#define CRYPTO_KEY_RESIDENCY_FREE_SLOTS        2
+#endif
+
+/*
+ * Number of per-user derived subkeys cached by the builtin key loader for each
+ * builtin key. 0 disables the cache.
+ */
+#ifndef TFM_BUILTIN_MAX_DERIVED_SUBKEYS
+#define TFM_BUILTIN_MAX_DERIVED_SUBKEYS        0
+#endif
+
+/*
+ * CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS can be defined to a brace-enclosed list
+ * of {key_id, owner} pairs, of persistent keys loaded at boot and never purged
+ * by the key slot residency tracking. Not defined by default.
+ */
+
 /* Enable PSA Crypto Key module */
 #ifndef CRYPTO_KEY_MODULE_ENABLED
 #define CRYPTO_KEY_MODULE_ENABLED              1
@@ -96,6 +139,11 @@
 #define CRYPTO_KEY_DERIVATION_MODULE_ENABLED   1
 #endif
 
+/* Enable the batch call, which runs a sequence of PSA Crypto requests in one message */
+#ifndef CRYPTO_BATCH_MODULE_ENABLED
+#define CRYPTO_BATCH_MODULE_ENABLED            0
+#endif
+
 /* Default size of the internal scratch buffer used for PSA FF IOVec allocations */
 #ifndef CRYPTO_IOVEC_BUFFER_SIZE
 #define CRYPTO_IOVEC_BUFFER_SIZE               5120
@@ -177,6 +225,20 @@
 #define ITS_RAM_FS                             0
 #endif
 
+/* The number of filesystem blocks cached in RAM by the ITS NAND flash
+ * backend, each of ITS_FLASH_NAND_BUF_SIZE bytes. At least 2.
+ */
+#ifndef ITS_FLASH_NAND_CACHE_BLOCKS
+#define ITS_FLASH_NAND_CACHE_BLOCKS            2
+#endif
+
+/* Leave the scratch blocks of the ITS filesystem to be erased by an explicit
+ * maintenance request, or by the next update, instead of after every update
+ */
+#ifndef ITS_DEFER_SCRATCH_ERASE
+#define ITS_DEFER_SCRATCH_ERASE                0
+#endif
+
 /* Validate filesystem metadata every time it is read from flash */
 #ifndef ITS_VALIDATE_METADATA_FROM_FLASH
 #define ITS_VALIDATE_METADATA_FROM_FLASH       1
@@ -237,6 +299,20 @@
 #define PS_ROLLBACK_PROTECTION                 1
 #endif
 
+/* The number of filesystem blocks cached in RAM by the PS NAND flash
+ * backend, each of PS_FLASH_NAND_BUF_SIZE bytes. At least 2.
+ */
+#ifndef PS_FLASH_NAND_CACHE_BLOCKS
+#define PS_FLASH_NAND_CACHE_BLOCKS             2
+#endif
+
+/* Leave the scratch blocks of the PS filesystem to be erased by an explicit
+ * ITS maintenance request, or by the next update, instead of after every update
+ */
+#ifndef PS_DEFER_SCRATCH_ERASE
+#define PS_DEFER_SCRATCH_ERASE                 0
+#endif
+
 /* Validate filesystem metadata every time it is read from flash */
 #ifndef PS_VALIDATE_METADATA_FROM_FLASH
 #define PS_VALIDATE_METADATA_FROM_FLASH        1
@@ -252,6 +328,13 @@
 #define PS_NUM_ASSETS                          10
 #endif
 
+/* The number of derived storage keys kept resident by Protected Storage.
+ * 0 derives a new key for each operation.
+ */
+#ifndef PS_CRYPTO_KEY_CACHE_SIZE
+#define PS_CRYPTO_KEY_CACHE_SIZE               0
+#endif
+
 /* The stack size of the Protected Storage Secure Partition */
 #ifndef PS_STACK_SIZE
 #define PS_STACK_SIZE                          0x700
@@ -307,6 +390,16 @@
 #define CONFIG_TFM_DOORBELL_API                 0
 #endif
 
+/* The maximal number of NS contexts, one per NS thread group, when NSPE OS manages NSID */
+#ifndef CONFIG_TFM_NS_CONTEXT_MAX
+#define CONFIG_TFM_NS_CONTEXT_MAX               1
+#endif
+
+/* Number of recently validated client memory ranges kept by SPM, 0 to disable */
+#ifndef CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES
+#define CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES   0
+#endif
+
 /*
  * Scheduling type for Hybrid Platforms (Currently in Experimental Stage)
  * Options can be found in spm/include/tfm_hybrid_platform.h
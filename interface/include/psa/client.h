@@ -61,9 +61,17 @@ typedef uint32_t rot_size_t;
 #define PSA_HANDLE_TO_ERROR(handle) ((psa_status_t)(handle))
 
 /**
- * Maximum number of input and output vectors for a request to psa_call().
- */
+ * Maximum total number of input plus output vectors for a request to
+ * psa_call().
+ * The PSA Firmware Framework defines it as 4, a larger value can be set with
+ * CONFIG_TFM_PSA_MAX_IOVEC for the secure and non-secure sides together. The
+ * build system passes that value with an unsigned suffix.
+ */
+#ifdef CONFIG_TFM_PSA_MAX_IOVEC
+#define PSA_MAX_IOVEC               (CONFIG_TFM_PSA_MAX_IOVEC)
+#else
 #define PSA_MAX_IOVEC               (4u)
+#endif
 
 
 /**
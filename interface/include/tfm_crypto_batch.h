@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_CRYPTO_BATCH_H__
+#define __TFM_CRYPTO_BATCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/client.h"
+#include "psa/crypto.h"
+#include "tfm_crypto_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Client side state of a batch of PSA Crypto requests, sent to the
+ *        Crypto service in a single psa_call. The requests and their results
+ *        are serialised into buffers provided by the caller.
+ *
+ * \note  The functions below are only built when the client sets
+ *        CONFIG_TFM_CRYPTO_BATCH_API to 1, and the batch call must be enabled
+ *        in the service through CRYPTO_BATCH_MODULE_ENABLED. A request which depends on the output of
+ *        a previous request of the same batch, e.g. the handle returned by a
+ *        setup function, can't be part of the same batch.
+ */
+struct tfm_crypto_batch_t {
+    uint8_t *req;       /*!< Request stream */
+    size_t req_size;    /*!< Size of the request buffer */
+    size_t req_len;     /*!< Bytes of the request stream in use */
+    uint8_t *rsp;       /*!< Response stream */
+    size_t rsp_size;    /*!< Size of the response buffer */
+    size_t rsp_len;     /*!< Bytes of the response stream reserved */
+    size_t op_count;    /*!< Number of operations in the batch */
+};
+
+/**
+ * \brief Initialises an empty batch
+ *
+ * \param[out] batch         Batch to initialise
+ * \param[in]  req_buf       Buffer for the request stream, 4-byte aligned
+ * \param[in]  req_buf_size  Size of \a req_buf in bytes
+ * \param[in]  rsp_buf       Buffer for the response stream, 4-byte aligned
+ * \param[in]  rsp_buf_size  Size of \a rsp_buf in bytes
+ *
+ * \return PSA_SUCCESS, or PSA_ERROR_INVALID_ARGUMENT if a buffer is misaligned
+ */
+psa_status_t tfm_crypto_batch_init(struct tfm_crypto_batch_t *batch,
+                                   void *req_buf, size_t req_buf_size,
+                                   void *rsp_buf, size_t rsp_buf_size);
+
+/**
+ * \brief Appends a request to a batch. The inputs are copied into the request
+ *        stream, and space for the outputs is reserved in the response stream.
+ *
+ * \param[in,out] batch     Batch to append the request to
+ * \param[in]     iov       Packed arguments of the request, as they would be
+ *                          passed as first input of its own psa_call
+ * \param[in]     in_vec    Inputs of the request, after the packed arguments
+ * \param[in]     in_len    Number of inputs
+ * \param[in]     out_size  Size of each output of the request
+ * \param[in]     out_len   Number of outputs
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_INVALID_ARGUMENT if the request has more than
+ *         TFM_CRYPTO_BATCH_MAX_IOVEC buffers, or PSA_ERROR_BUFFER_TOO_SMALL if
+ *         the request or response buffer is full
+ */
+psa_status_t tfm_crypto_batch_add(struct tfm_crypto_batch_t *batch,
+                                  const struct tfm_crypto_pack_iovec *iov,
+                                  const psa_invec *in_vec, size_t in_len,
+                                  const size_t *out_size, size_t out_len);
+
+/**
+ * \brief Appends a psa_hash_update() request on an already set up operation
+ *
+ * \param[in,out] batch      Batch to append the request to
+ * \param[in]     operation  Hash operation to update
+ * \param[in]     input      Data to hash
+ * \param[in]     input_length  Length of \a input in bytes
+ *
+ * \return As tfm_crypto_batch_add()
+ */
+psa_status_t tfm_crypto_batch_add_hash_update(struct tfm_crypto_batch_t *batch,
+                                              const psa_hash_operation_t *operation,
+                                              const uint8_t *input,
+                                              size_t input_length);
+
+/**
+ * \brief Sends the batch to the Crypto service, which runs the requests in
+ *        order and stops at the first one that fails
+ *
+ * \param[in] batch  Batch to send
+ *
+ * \return PSA_SUCCESS if all requests succeeded, the status of the failing
+ *         request otherwise. The result of each request is retrieved with
+ *         tfm_crypto_batch_get_result().
+ */
+psa_status_t tfm_crypto_batch_call(struct tfm_crypto_batch_t *batch);
+
+/**
+ * \brief Retrieves the result of a request of a batch that has been sent
+ *
+ * \param[in]  batch    Batch that has been sent
+ * \param[in]  idx      Index of the request, in the order it was added
+ * \param[out] out_vec  Filled with the location and length of each output of
+ *                      the request, inside the response buffer
+ * \param[in]  out_len  Number of elements of \a out_vec
+ *
+ * \return The status of the request, PSA_OPERATION_INCOMPLETE if it was not
+ *         run because an earlier request failed, or PSA_ERROR_INVALID_ARGUMENT
+ *         if \a idx or \a out_len don't match the batch
+ */
+psa_status_t tfm_crypto_batch_get_result(const struct tfm_crypto_batch_t *batch,
+                                         size_t idx,
+                                         psa_outvec *out_vec, size_t out_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_CRYPTO_BATCH_H__ */
@@ -62,10 +62,49 @@ struct tfm_crypto_pack_iovec {
     };
 };
 
+/**
+ * \brief Maximum number of buffers, inputs and outputs together, that a single
+ *        operation of a batch can pass besides its tfm_crypto_pack_iovec. It
+ *        matches what the operation could pass through its own psa_call.
+ */
+#define TFM_CRYPTO_BATCH_MAX_IOVEC (3u)
+
+/**
+ * \brief Rounds a length in a batch request or response up to the 4-byte
+ *        alignment at which the next buffer or header starts
+ */
+#define TFM_CRYPTO_BATCH_ALIGN(_len) (((_len) + 3u) & ~(size_t)3u)
+
+/**
+ * \brief Header of an operation in a batch request. It is followed in the
+ *        request by \a in_count input buffers of the given lengths, each one
+ *        starting at a 4-byte aligned offset.
+ */
+struct tfm_crypto_batch_entry {
+    struct tfm_crypto_pack_iovec iov;  /*!< Packed arguments of the operation */
+    uint8_t in_count;                  /*!< Number of input buffers */
+    uint8_t out_count;                 /*!< Number of output buffers */
+    uint16_t reserved;                 /*!< Must be zero */
+    uint32_t in_len[TFM_CRYPTO_BATCH_MAX_IOVEC];  /*!< Length of each input */
+    uint32_t out_len[TFM_CRYPTO_BATCH_MAX_IOVEC]; /*!< Size of each output */
+};
+
+/**
+ * \brief Header of an operation in a batch response. It is followed in the
+ *        response by \a out_count output buffers of the sizes requested in the
+ *        matching tfm_crypto_batch_entry, each one starting at a 4-byte aligned
+ *        offset. Operations after the first failing one are not run, and their
+ *        headers are left as initialised by the client.
+ */
+struct tfm_crypto_batch_result {
+    psa_status_t status;                          /*!< Status of the operation */
+    uint32_t out_len[TFM_CRYPTO_BATCH_MAX_IOVEC]; /*!< Bytes written to each output */
+};
+
 /**
  * \brief Type associated to the group of a function encoding. There can be
- *        nine groups (Random, Key management, Hash, MAC, Cipher, AEAD,
- *        Asym sign, Asym encrypt, Key derivation).
+ *        ten groups (Random, Key management, Hash, MAC, Cipher, AEAD,
+ *        Asym sign, Asym encrypt, Key derivation, Batch).
  */
 enum tfm_crypto_group_id_t {
     TFM_CRYPTO_GROUP_ID_RANDOM          = UINT8_C(1),
@@ -76,7 +115,8 @@ enum tfm_crypto_group_id_t {
     TFM_CRYPTO_GROUP_ID_AEAD            = UINT8_C(6),
     TFM_CRYPTO_GROUP_ID_ASYM_SIGN       = UINT8_C(7),
     TFM_CRYPTO_GROUP_ID_ASYM_ENCRYPT    = UINT8_C(8),
-    TFM_CRYPTO_GROUP_ID_KEY_DERIVATION  = UINT8_C(9)
+    TFM_CRYPTO_GROUP_ID_KEY_DERIVATION  = UINT8_C(9),
+    TFM_CRYPTO_GROUP_ID_BATCH           = UINT8_C(10)
 };
 
 /* Set of X macros describing each of the available PSA Crypto APIs */
@@ -163,6 +203,9 @@ enum tfm_crypto_group_id_t {
     X(TFM_CRYPTO_KEY_DERIVATION_OUTPUT_KEY)        \
     X(TFM_CRYPTO_KEY_DERIVATION_ABORT)
 
+#define BATCH_FUNCS                                \
+    X(TFM_CRYPTO_BATCH_CALL)
+
 #define BASE__VALUE(x) ((uint16_t)((((uint16_t)(x)) << 8) & 0xFF00))
 
 /**
@@ -197,6 +240,8 @@ enum tfm_crypto_func_sid_t {
     ASYM_ENCRYPT_FUNCS
     BASE__KEY_DERIVATION = BASE__VALUE(TFM_CRYPTO_GROUP_ID_KEY_DERIVATION) - 1,
     KEY_DERIVATION_FUNCS
+    BASE__BATCH          = BASE__VALUE(TFM_CRYPTO_GROUP_ID_BATCH) - 1,
+    BATCH_FUNCS
 #undef X
 };
 
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_ITS_API_H__
+#define __TFM_ITS_API_H__
+
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Asks the ITS service to do the filesystem maintenance that it has
+ *        deferred, so that it is not done by the next write or remove. It is
+ *        meant to be called when the system is otherwise idle.
+ *
+ * \note  Maintenance is only deferred when ITS_DEFER_SCRATCH_ERASE or
+ *        PS_DEFER_SCRATCH_ERASE is enabled. Otherwise, this does nothing.
+ *
+ * \return PSA_SUCCESS, or PSA_ERROR_STORAGE_FAILURE if the storage failed
+ */
+psa_status_t tfm_its_maintain(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_ITS_API_H__ */
@@ -20,6 +20,7 @@ extern "C" {
 #define TFM_ITS_GET                1002
 #define TFM_ITS_GET_INFO           1003
 #define TFM_ITS_REMOVE             1004
+#define TFM_ITS_MAINTAIN           1005
 
 #ifdef __cplusplus
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,21 +15,36 @@ extern "C" {
 #endif
 
 /*
- *  31           30-28   27    26-24  23-20   19     18-16   15-0
- * +------------+-----+------+-------+-----+-------+-------+------+
- * | NS vector  |     | NS   | invec |     | NS    | outvec| type |
- * | descriptor | Res | invec| number| Res | outvec| number|      |
- * +------------+-----+------+-------+-----+-------+-------+------+
+ *  31           30    29-28  27    26-24  23-22  21-20  19     18-16   15-0
+ * +------------+-----+------+-----+------+-----+------+------+-------+------+
+ * | NS vector  |     | invec| NS  | invec|     |outvec| NS   | outvec| type |
+ * | descriptor | Res | num  |invec| num  | Res | num  |outvec| num   |      |
+ * |            |     | high |     | low  |     | high |      | low   |      |
+ * +------------+-----+------+-----+------+-----+------+------+-------+------+
  *
  * Res: Reserved.
+ *
+ * The high bits of the vector numbers are only used when PSA_MAX_IOVEC is
+ * configured above 7, so the encoding of smaller calls is unchanged.
  */
 #define TYPE_MASK            0xFFFFUL
 
 #define IN_LEN_OFFSET        24
 #define IN_LEN_MASK          (0x7UL << IN_LEN_OFFSET)
+#define IN_LEN_HIGH_OFFSET   28
+#define IN_LEN_HIGH_MASK     (0x3UL << IN_LEN_HIGH_OFFSET)
 
 #define OUT_LEN_OFFSET       16
 #define OUT_LEN_MASK         (0x7UL << OUT_LEN_OFFSET)
+#define OUT_LEN_HIGH_OFFSET  20
+#define OUT_LEN_HIGH_MASK    (0x3UL << OUT_LEN_HIGH_OFFSET)
+
+/* Number of low bits of a vector number, below the high bits */
+#define LEN_LOW_BITS         3
+
+#if PSA_MAX_IOVEC > 31
+#error "PSA_MAX_IOVEC can't be encoded in the psa_call() control parameter"
+#endif
 
 /*
  * NS_VEC_DESC_BIT is referenced by inline assembly, which does not
@@ -43,19 +58,27 @@ extern "C" {
 #define NS_OUTVEC_OFFSET     19
 #define NS_OUTVEC_BIT        (1UL << NS_OUTVEC_OFFSET)
 
-#define PARAM_PACK(type, in_len, out_len)                            \
-          ((((uint32_t)(type)) & TYPE_MASK)                        | \
-           ((((uint32_t)(in_len)) << IN_LEN_OFFSET) & IN_LEN_MASK) | \
-           ((((uint32_t)(out_len)) << OUT_LEN_OFFSET) & OUT_LEN_MASK))
+#define PARAM_PACK(type, in_len, out_len)                                   \
+          ((((uint32_t)(type)) & TYPE_MASK)                               | \
+           ((((uint32_t)(in_len)) << IN_LEN_OFFSET) & IN_LEN_MASK)        | \
+           (((((uint32_t)(in_len)) >> LEN_LOW_BITS) << IN_LEN_HIGH_OFFSET) & \
+            IN_LEN_HIGH_MASK)                                             | \
+           ((((uint32_t)(out_len)) << OUT_LEN_OFFSET) & OUT_LEN_MASK)     | \
+           (((((uint32_t)(out_len)) >> LEN_LOW_BITS) << OUT_LEN_HIGH_OFFSET) & \
+            OUT_LEN_HIGH_MASK))
 
 #define PARAM_UNPACK_TYPE(ctrl_param)                                \
           ((int32_t)(int16_t)((ctrl_param) & TYPE_MASK))
 
 #define PARAM_UNPACK_IN_LEN(ctrl_param)                              \
-          ((size_t)(((ctrl_param) & IN_LEN_MASK) >> IN_LEN_OFFSET))
+          ((size_t)((((ctrl_param) & IN_LEN_MASK) >> IN_LEN_OFFSET) | \
+                    ((((ctrl_param) & IN_LEN_HIGH_MASK) >>            \
+                      IN_LEN_HIGH_OFFSET) << LEN_LOW_BITS)))
 
 #define PARAM_UNPACK_OUT_LEN(ctrl_param)                             \
-          ((size_t)(((ctrl_param) & OUT_LEN_MASK) >> OUT_LEN_OFFSET))
+          ((size_t)((((ctrl_param) & OUT_LEN_MASK) >> OUT_LEN_OFFSET) | \
+                    ((((ctrl_param) & OUT_LEN_HIGH_MASK) >>             \
+                      OUT_LEN_HIGH_OFFSET) << LEN_LOW_BITS)))
 
 #define PARAM_SET_NS_VEC(ctrl_param)    ((ctrl_param) | NS_VEC_DESC_BIT)
 #define PARAM_IS_NS_VEC(ctrl_param)     ((ctrl_param) & NS_VEC_DESC_BIT)
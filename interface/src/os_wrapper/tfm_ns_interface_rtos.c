@@ -10,6 +10,16 @@
 /* This file provides implementation of TF-M NS os wrapper functions for the
  * RTOS use case. This implementation provides multithread safety, so it
  * can be used in RTOS environment.
+ *
+ * \note  All the secure calls are serialized, whichever service they target.
+ *        With TrustZone, the NS agent serves the calls from a single secure
+ *        context and stack, and the veneers reject a call made while another
+ *        one is still in progress, so calls from different NS threads can't
+ *        overlap even when the SPM runs the target partitions separately.
+ *        NS client contexts only carry the client identity of the thread
+ *        that is scheduled in. On multi-core platforms, the NS mailbox
+ *        interface is used instead, where up to NUM_MAILBOX_QUEUE_SLOT calls
+ *        from different threads are in progress at the same time.
  */
 
 #include <stdint.h>
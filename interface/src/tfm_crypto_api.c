@@ -10,6 +10,9 @@
 #include <string.h>
 
 #include "tfm_crypto_defs.h"
+#if CONFIG_TFM_CRYPTO_BATCH_API == 1
+#include "tfm_crypto_batch.h"
+#endif /* CONFIG_TFM_CRYPTO_BATCH_API */
 
 #include "psa/client.h"
 #include "psa_manifest/sid.h"
@@ -38,6 +41,19 @@
  *        it's for NS applications and system integrators to enable.
  */
 
+/*!
+ * \def CONFIG_TFM_CRYPTO_BATCH_API
+ *
+ * \brief By setting this to 1, the client side functions declared in
+ *        tfm_crypto_batch.h, which build and send batches of PSA Crypto
+ *        requests, are built. It must only be set when the Crypto service is
+ *        built with CRYPTO_BATCH_MODULE_ENABLED, which rejects batches
+ *        otherwise.
+ *
+ * \note  This config option is not available through the TF-M configuration as
+ *        it's for NS applications and system integrators to enable.
+ */
+
 /*!
  * \def TFM_CRYPTO_API(ret, fun)
  *
@@ -1707,6 +1723,165 @@ TFM_CRYPTO_API(psa_status_t, psa_key_derivation_verify_key)(
     return PSA_ERROR_NOT_SUPPORTED;
 }
 
+#if CONFIG_TFM_CRYPTO_BATCH_API == 1
+psa_status_t tfm_crypto_batch_init(struct tfm_crypto_batch_t *batch,
+                                   void *req_buf, size_t req_buf_size,
+                                   void *rsp_buf, size_t rsp_buf_size)
+{
+    /* Headers and buffers are laid out at 4-byte aligned offsets */
+    if ((((uintptr_t)req_buf | (uintptr_t)rsp_buf) & 0x3u) != 0) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    batch->req = req_buf;
+    batch->req_size = req_buf_size;
+    batch->req_len = 0;
+    batch->rsp = rsp_buf;
+    batch->rsp_size = rsp_buf_size;
+    batch->rsp_len = 0;
+    batch->op_count = 0;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_crypto_batch_add(struct tfm_crypto_batch_t *batch,
+                                  const struct tfm_crypto_pack_iovec *iov,
+                                  const psa_invec *in_vec, size_t in_len,
+                                  const size_t *out_size, size_t out_len)
+{
+    struct tfm_crypto_batch_entry entry = {0};
+    struct tfm_crypto_batch_result result = {0};
+    size_t req_len = batch->req_len + sizeof(entry);
+    size_t rsp_len = batch->rsp_len + sizeof(result);
+    size_t i;
+
+    if (in_len + out_len > TFM_CRYPTO_BATCH_MAX_IOVEC) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Check that the whole request fits before writing any of it */
+    for (i = 0; i < in_len; i++) {
+        req_len = TFM_CRYPTO_BATCH_ALIGN(req_len + in_vec[i].len);
+    }
+    for (i = 0; i < out_len; i++) {
+        rsp_len = TFM_CRYPTO_BATCH_ALIGN(rsp_len + out_size[i]);
+    }
+    if ((req_len > batch->req_size) || (rsp_len > batch->rsp_size)) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(&entry.iov, iov, sizeof(entry.iov));
+    entry.in_count = (uint8_t)in_len;
+    entry.out_count = (uint8_t)out_len;
+    for (i = 0; i < in_len; i++) {
+        entry.in_len[i] = (uint32_t)in_vec[i].len;
+    }
+    for (i = 0; i < out_len; i++) {
+        entry.out_len[i] = (uint32_t)out_size[i];
+    }
+
+    memcpy(&batch->req[batch->req_len], &entry, sizeof(entry));
+    batch->req_len += sizeof(entry);
+    for (i = 0; i < in_len; i++) {
+        memcpy(&batch->req[batch->req_len], in_vec[i].base, in_vec[i].len);
+        batch->req_len = TFM_CRYPTO_BATCH_ALIGN(batch->req_len + in_vec[i].len);
+    }
+
+    /* The service only writes the results of the requests it runs */
+    result.status = PSA_OPERATION_INCOMPLETE;
+    memcpy(&batch->rsp[batch->rsp_len], &result, sizeof(result));
+    batch->rsp_len = rsp_len;
+
+    batch->op_count++;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_crypto_batch_add_hash_update(struct tfm_crypto_batch_t *batch,
+                                              const psa_hash_operation_t *operation,
+                                              const uint8_t *input,
+                                              size_t input_length)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_HASH_UPDATE_SID,
+        .op_handle = operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = input, .len = input_length},
+    };
+
+    return tfm_crypto_batch_add(batch, &iov, in_vec, IOVEC_LEN(in_vec), NULL, 0);
+}
+
+psa_status_t tfm_crypto_batch_call(struct tfm_crypto_batch_t *batch)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_BATCH_CALL_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = batch->req, .len = batch->req_len},
+    };
+
+    psa_outvec out_vec[] = {
+        {.base = batch->rsp, .len = batch->rsp_len},
+    };
+
+    if (batch->op_count == 0) {
+        return PSA_SUCCESS;
+    }
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
+psa_status_t tfm_crypto_batch_get_result(const struct tfm_crypto_batch_t *batch,
+                                         size_t idx,
+                                         psa_outvec *out_vec, size_t out_len)
+{
+    struct tfm_crypto_batch_entry entry;
+    struct tfm_crypto_batch_result result;
+    size_t req_off = 0, rsp_off = 0, op, i;
+
+    if (idx >= batch->op_count) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Walk the request stream, as the position of a result depends on the
+     * output sizes of all the requests before it
+     */
+    for (op = 0; ; op++) {
+        memcpy(&entry, &batch->req[req_off], sizeof(entry));
+        if (op == idx) {
+            break;
+        }
+        req_off += sizeof(entry);
+        for (i = 0; i < entry.in_count; i++) {
+            req_off = TFM_CRYPTO_BATCH_ALIGN(req_off + entry.in_len[i]);
+        }
+        rsp_off += sizeof(result);
+        for (i = 0; i < entry.out_count; i++) {
+            rsp_off = TFM_CRYPTO_BATCH_ALIGN(rsp_off + entry.out_len[i]);
+        }
+    }
+
+    if (out_len != entry.out_count) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    memcpy(&result, &batch->rsp[rsp_off], sizeof(result));
+    rsp_off += sizeof(result);
+    for (i = 0; i < out_len; i++) {
+        out_vec[i].base = &batch->rsp[rsp_off];
+        out_vec[i].len = result.out_len[i];
+        rsp_off = TFM_CRYPTO_BATCH_ALIGN(rsp_off + entry.out_len[i]);
+    }
+
+    return result.status;
+}
+#endif /* CONFIG_TFM_CRYPTO_BATCH_API */
+
 /* The implementation of the following helper function is marked
  * weak to allow for those integrations where this is directly
  * provided by the psa_crypto_client.c module of Mbed TLS
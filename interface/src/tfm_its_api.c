@@ -8,6 +8,7 @@
 #include "psa/client.h"
 #include "psa/internal_trusted_storage.h"
 #include "psa_manifest/sid.h"
+#include "tfm_its_api.h"
 #include "tfm_its_defs.h"
 
 struct rot_psa_its_storage_info_t {
@@ -112,3 +113,9 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
 
     return status;
 }
+
+psa_status_t tfm_its_maintain(void)
+{
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_MAINTAIN, NULL, 0, NULL, 0);
+}
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Stand-in for the DMA copy HAL on platforms without a DMA, which does the
+ * copies with the CPU. It completes each copy before returning from
+ * tfm_hal_dma_copy_start(), which allows the callers of the HAL to be run on
+ * any target.
+ */
+
+#include <string.h>
+
+#include "tfm_hal_dma_copy.h"
+
+#ifndef TFM_HAL_DMA_COPY_MIN_SIZE
+#define TFM_HAL_DMA_COPY_MIN_SIZE 256
+#endif
+
+size_t tfm_hal_dma_copy_min_size(void)
+{
+    return TFM_HAL_DMA_COPY_MIN_SIZE;
+}
+
+enum tfm_hal_status_t tfm_hal_dma_copy_start(void *dest, const void *src, size_t n)
+{
+    if ((dest == NULL) || (src == NULL)) {
+        return TFM_HAL_ERROR_INVALID_INPUT;
+    }
+
+    memcpy(dest, src, n);
+
+    return TFM_HAL_SUCCESS;
+}
+
+bool tfm_hal_dma_copy_is_done(void)
+{
+    return true;
+}
+
+enum tfm_hal_status_t tfm_hal_dma_copy_wait(void)
+{
+    return TFM_HAL_SUCCESS;
+}
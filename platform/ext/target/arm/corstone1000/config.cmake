@@ -66,6 +66,8 @@ endif()
 
 # Platform-specific configurations
 set(CONFIG_TFM_USE_TRUSTZONE            OFF)
+# The firmware update agent sets the NV counters of accepted images
+set(PLATFORM_HAS_NV_COUNTER_WRITERS_OUTSIDE_SERVICE ON)
 set(TFM_MULTI_CORE_TOPOLOGY             ON)
 set(PS_NUM_ASSETS                       "40"        CACHE STRING    "The maximum number of assets to be stored in the Protected Storage area")
 
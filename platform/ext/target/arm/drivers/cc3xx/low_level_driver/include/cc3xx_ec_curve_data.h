@@ -107,6 +107,18 @@ typedef enum {
 #define CC3XX_EC_MAX_BARRETT_TAG_SIZE 0
 #endif
 
+#if defined(CC3XX_CONFIG_EC_CURVE_SECP_256_R1_GENERATOR_COMB_ENABLE) \
+ || defined(CC3XX_CONFIG_EC_CURVE_SECP_384_R1_GENERATOR_COMB_ENABLE)
+#define CC3XX_EC_GENERATOR_COMB_ENABLE
+#endif
+
+/**
+ * @brief The number of rows of the fixed-base comb used to multiply the
+ *        generator, for the curves which have a precomputed table. The table
+ *        holds 2^(width - 1) points.
+ */
+#define CC3XX_EC_GENERATOR_COMB_WIDTH 5
+
 /**
  * @brief Structure describing Elliptic Curve parameters
  *
@@ -130,6 +142,9 @@ typedef struct {
 
     uint32_t order[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
     uint32_t cofactor;
+
+    const uint32_t *generator_comb_table; /*!< Generator multiples for the comb, NULL if not enabled */
+    size_t generator_comb_columns;        /*!< Number of columns of the comb */
 } cc3xx_ec_curve_data_t;
 
 extern const cc3xx_ec_curve_data_t secp_192_r1;
@@ -23,6 +23,23 @@ extern "C" {
 #define CC3XX_ECDSA_MAX_PRIVATE_KEY_SIZE      CC3XX_EC_MAX_POINT_SIZE
 #define CC3XX_ECDSA_MAX_PUBLIC_COORD_KEY_SIZE CC3XX_EC_MAX_POINT_SIZE
 
+/**
+ * @brief One signature to be checked by \ref cc3xx_lowlevel_ecdsa_verify_batch.
+ *        The fields are as for the parameters of \ref cc3xx_lowlevel_ecdsa_verify
+ */
+struct cc3xx_ecdsa_verify_batch_entry_t {
+    const uint32_t *public_key_x;
+    size_t public_key_x_len;
+    const uint32_t *public_key_y;
+    size_t public_key_y_len;
+    const uint32_t *hash;
+    size_t hash_len;
+    const uint32_t *sig_r;
+    size_t sig_r_len;
+    const uint32_t *sig_s;
+    size_t sig_s_len;
+};
+
 /**
  * @brief                        Generate an ECDSA private key
  *
@@ -153,6 +170,34 @@ cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
                                         const uint32_t *sig_r, size_t sig_r_len,
                                         const uint32_t *sig_s, size_t sig_s_len);
 
+/**
+ * @brief                        Verify several ECDSA signatures on the same
+ *                               curve
+ *
+ * @note                         The curve is only set up in the PKA once for
+ *                               the whole batch. The public key is only loaded
+ *                               and validated again when it differs from the
+ *                               one of the previous entry, so entries which
+ *                               share a key should be adjacent and point to
+ *                               the same key buffers.
+ *
+ * @param[in]  curve_id          The ID of the curve that the signatures were
+ *                               generated using.
+ * @param[in]  entries           The signatures to verify.
+ * @param[in]  entry_amount      The amount of entries.
+ * @param[out] results           If not NULL, a buffer of entry_amount elements
+ *                               to write the result of each verification into.
+ *                               If NULL, verification stops at the first
+ *                               failure.
+ *
+ * @return                       CC3XX_ERR_SUCCESS if all the signatures are
+ *                               valid, another cc3xx_err_t on error.
+ */
+cc3xx_err_t cc3xx_lowlevel_ecdsa_verify_batch(cc3xx_ec_curve_id_t curve_id,
+                        const struct cc3xx_ecdsa_verify_batch_entry_t *entries,
+                        size_t entry_amount,
+                        cc3xx_err_t *results);
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,6 +43,14 @@ struct cc3xx_hash_state_t {
     struct cc3xx_dma_state_t dma_state;
 };
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+struct cc3xx_hash_residency_stats_t {
+    uint32_t hits;     /* Acquires where the state was already resident */
+    uint32_t restores; /* Acquires which loaded the state into the engine */
+    uint32_t saves;    /* Resident states saved back due to preemption */
+};
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -68,6 +76,30 @@ cc3xx_err_t cc3xx_lowlevel_hash_init(cc3xx_hash_alg_t alg);
  */
 cc3xx_err_t cc3xx_lowlevel_hash_update(const uint8_t *buf, size_t length);
 
+/**
+ * @brief                        Input data into a hash operation, and copy it
+ *                               to an output buffer in the same pass.
+ *
+ * @note                         If the hardware supports the hash-and-bypass
+ *                               flow (CC3XX_CONFIG_HASH_AND_BYPASS_ENABLE), the
+ *                               DMA routes the input to both the hash engine
+ *                               and the output, so the input is only read
+ *                               once. At most two blocks at the edges of the
+ *                               input are copied by the CPU. Otherwise, the
+ *                               data is copied first and the hash is computed
+ *                               over the copy.
+ *
+ * @param[in]  buf               A pointer to the data to be input.
+ * @param[in]  length            The size of the data to be input.
+ * @param[out] out               A pointer to copy the data to. Must be at
+ *                               least length bytes, and must not overlap buf.
+ *
+ * @return                       CC3XX_ERR_SUCCESS on success, another
+ *                               cc3xx_err_t on error.
+ */
+cc3xx_err_t cc3xx_lowlevel_hash_update_and_copy(const uint8_t *buf, size_t length,
+                                                uint8_t *out);
+
 /**
  * @brief                        Get the current state of the hash operation.
  *                               Allows for restartable hash operations.
@@ -87,6 +119,57 @@ void cc3xx_lowlevel_hash_get_state(struct cc3xx_hash_state_t *state);
  */
 void cc3xx_lowlevel_hash_set_state(const struct cc3xx_hash_state_t *state);
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+/**
+ * @brief                        Make a saved hash state resident in the hash
+ *                               engine, so that it can be updated or finished.
+ *
+ * @note                         If the state is already resident, this does
+ *                               nothing. Otherwise the currently resident
+ *                               state (if any) is saved back to its owner
+ *                               before this state is loaded. While resident,
+ *                               the contents of the state structure are stale
+ *                               and must not be read or copied, and the
+ *                               structure must not be freed without a call to
+ *                               cc3xx_lowlevel_hash_release_state.
+ *
+ * @param[in]  state             The cc3xx_hash_state_t to make resident.
+ */
+void cc3xx_lowlevel_hash_acquire_state(struct cc3xx_hash_state_t *state);
+
+/**
+ * @brief                        Give up residency of a hash state without
+ *                               saving it. If the state is resident, the hash
+ *                               engine is uninitialized.
+ *
+ * @param[in]  state             The cc3xx_hash_state_t to release.
+ */
+void cc3xx_lowlevel_hash_release_state(const struct cc3xx_hash_state_t *state);
+
+/**
+ * @brief                        Save the resident hash state (if any) back to
+ *                               its owner, and uninitialize the hash engine.
+ *
+ * @note                         This is called by every driver entry point
+ *                               that reconfigures the engine or the DMA, so
+ *                               that a resident state is never overwritten.
+ */
+void cc3xx_lowlevel_hash_evict_resident_state(void);
+
+/**
+ * @brief                        Get the state residency counters.
+ *
+ * @param[out] stats             The structure to write the counters into.
+ */
+void cc3xx_lowlevel_hash_get_residency_stats(
+    struct cc3xx_hash_residency_stats_t *stats);
+
+/**
+ * @brief                        Reset the state residency counters to zero.
+ */
+void cc3xx_lowlevel_hash_reset_residency_stats(void);
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
 /**
  * @brief                        Finish a hash operation, and output the hash.
  *
@@ -567,6 +567,10 @@ cc3xx_err_t cc3xx_lowlevel_aes_set_state(const struct cc3xx_aes_state_t *state)
 {
     cc3xx_err_t err;
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_evict_resident_state();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
 #ifdef CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE
     memcpy(&aes_state, state, sizeof(*state));
     cc3xx_dpa_hardened_word_copy(aes_state.key_buf,
@@ -9,6 +9,7 @@
 
 #include "cc3xx_dev.h"
 #include "cc3xx_engine_state.h"
+#include "cc3xx_hash.h"
 #include "cc3xx_stdlib.h"
 #include "cc3xx_rng.h"
 
@@ -192,6 +193,10 @@ void cc3xx_lowlevel_chacha20_get_state(struct cc3xx_chacha_state_t *state)
 
 void cc3xx_lowlevel_chacha20_set_state(const struct cc3xx_chacha_state_t *state)
 {
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_evict_resident_state();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
     memcpy(&chacha_state, state, sizeof(struct cc3xx_chacha_state_t));
     memcpy(&dma_state, &state->dma_state, sizeof(dma_state));
 
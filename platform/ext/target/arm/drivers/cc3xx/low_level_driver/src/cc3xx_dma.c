@@ -9,6 +9,7 @@
 
 #include "cc3xx_dev.h"
 #include "cc3xx_engine_state.h"
+#include "cc3xx_hash.h"
 #ifndef CC3XX_CONFIG_FILE
 #include "cc3xx_config.h"
 #else
@@ -167,6 +168,10 @@ static void process_data(const void* buf, size_t length)
 
 void cc3xx_lowlevel_dma_copy_data(void* dest, const void* src, size_t length)
 {
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_evict_resident_state();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
     /* Set to PASSTHROUGH engine */
     cc3xx_lowlevel_set_engine(CC3XX_ENGINE_NONE);
 
@@ -276,5 +281,9 @@ void cc3xx_lowlevel_dma_set_output(void* buf, size_t length)
 
 void cc3xx_lowlevel_dma_uninit(void)
 {
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_evict_resident_state();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
     memset(&dma_state, 0, sizeof(dma_state));
 }
@@ -76,6 +76,95 @@ const cc3xx_ec_curve_data_t secp_224_r1 = {
 #endif
 
 #ifdef CC3XX_CONFIG_EC_CURVE_SECP_256_R1_ENABLE
+#ifdef CC3XX_CONFIG_EC_CURVE_SECP_256_R1_GENERATOR_COMB_ENABLE
+/* Multiples of the generator used by the fixed-base comb, for a comb of
+ * CC3XX_EC_GENERATOR_COMB_WIDTH rows and 52 columns. Entry i holds
+ * (1 + sum of 2^(52 * j) for each bit j - 1 set in i) * G in affine coordinates.
+ */
+static const uint32_t secp_256_r1_generator_comb[] = {
+    /* G */
+    0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+    0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+    0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+    0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2,
+    /* G + 2^52 G */
+    0x04BAC870, 0xF7D24BB7, 0x3A23C6AB, 0x593A09A0,
+    0xF94C9D1D, 0xDFCC2358, 0x297BED02, 0x3CFA0F87,
+    0x40F26940, 0xCE98A30B, 0x0248A8AF, 0x62121C0D,
+    0x8309AF9B, 0xA758AA80, 0x70BE12C6, 0xE4E37694,
+    /* G + 2^104 G */
+    0x86EF7D7D, 0xDD37E3FF, 0x088B86DB, 0xF6D77C27,
+    0x254C5491, 0x28FE9A4F, 0x6DF0FD5E, 0xD6690337,
+    0xADDAD596, 0x9FF04992, 0x9E4373F9, 0xF3D1A7AF,
+    0xDF074167, 0xA13E9578, 0xE6D13D22, 0x20E2A53C,
+    /* G + 2^52 G + 2^104 G */
+    0x525D6ABF, 0xAEBFD735, 0x96BEA25A, 0xC302F8F4,
+    0x544920A4, 0xDB82B3EA, 0x02EADB2E, 0x621C75D1,
+    0x9EF485F0, 0x8939DC4C, 0x57C46D63, 0x225D03D8,
+    0x522D7F70, 0x4FDAC96F, 0xB4FA649D, 0xD7C4A4FE,
+    /* G + 2^156 G */
+    0xC0B9372A, 0x8BC659AA, 0xEDD9583F, 0xF7659958,
+    0x8C267D88, 0x9F05F94A, 0xC99A739D, 0x00DC46E7,
+    0xDF55D0F2, 0x4AF50A00, 0x8156BF6A, 0xB5EB202D,
+    0x5228C111, 0x40D1E3AB, 0x45793424, 0x0312A557,
+    /* G + 2^52 G + 2^156 G */
+    0x7EB8CFEE, 0x8D9692F7, 0x0D8C013D, 0x05E3F223,
+    0x84E32E59, 0x76347A52, 0x15B0A1E5, 0x3C53E290,
+    0xFAE798D4, 0x538B7DA5, 0x00D23591, 0x1B9F1BD1,
+    0x9A08693F, 0x11A9F072, 0x140EFEB3, 0xD30E7CDA,
+    /* G + 2^104 G + 2^156 G */
+    0xF8E8F683, 0x6DFCF787, 0x3F7FBE90, 0x13D72B7A,
+    0x2DF232CF, 0xFD426D94, 0x5FE39AAD, 0xED84BB42,
+    0x732995FC, 0x023E67A1, 0x355430E3, 0x67DD0A8E,
+    0x97A1D703, 0x0CF83B61, 0x583C33F2, 0xA3233455,
+    /* G + 2^52 G + 2^104 G + 2^156 G */
+    0x5F165D99, 0xCEBBBC7B, 0x8A4EEE61, 0x50CC51C1,
+    0x1B4D0D1F, 0xB31D2353, 0x66382ADA, 0x95E18452,
+    0x0A839B5B, 0xACAD4F81, 0x4142FF0F, 0xA0A2A96E,
+    0x1F4FA12F, 0x3EAA8289, 0x6B0FB8F3, 0x68D68C8F,
+    /* G + 2^208 G */
+    0x51BBB3F1, 0x9311A269, 0x8D0F4F65, 0xE80F26BD,
+    0x6BECCBB9, 0x9D3DC334, 0x101E5DE4, 0x54E244D5,
+    0xF1B19E28, 0xB3AD4C6E, 0x58C2E3B7, 0x4334FBC0,
+    0x35DF9C25, 0x19BD4107, 0xEC106EB6, 0xD6BBEC0E,
+    /* G + 2^52 G + 2^208 G */
+    0x3FEFCFC8, 0xE8881A83, 0xB9B5290B, 0xAEA3C9E0,
+    0x771E4688, 0x10B37ECD, 0xD4D021B6, 0xEE0816A3,
+    0xB3A8CAA1, 0x8E9929BF, 0xC105F2D1, 0x48915DCF,
+    0xDB49019F, 0x3A5FDF82, 0xAD9006E1, 0xC4A438E3,
+    /* G + 2^104 G + 2^208 G */
+    0xE83AD2C9, 0x5D6DC503, 0xAED035BE, 0xCA9F7A1D,
+    0xCBD21E33, 0x552788AC, 0xE09CB9F0, 0x8699DD31,
+    0x329BF961, 0x38584196, 0xB82A5AF9, 0x4CB20E96,
+    0xC72C78C1, 0x24199908, 0xE92859B7, 0x16E65484,
+    /* G + 2^52 G + 2^104 G + 2^208 G */
+    0xDB3038DD, 0xA20A2C70, 0xE99D5C7C, 0x5F0B46D5,
+    0x4B600B83, 0xC9B97D37, 0x3DF3245E, 0x186C7F79,
+    0x4F1CE57F, 0x2AF72460, 0x91E2D8ED, 0x9249897F,
+    0x8D2EA797, 0x8139B36A, 0x9AB58913, 0x9C428DB8,
+    /* G + 2^156 G + 2^208 G */
+    0x4BE6458D, 0x1F1E4F3F, 0x595E6547, 0x5F72CC22,
+    0x271A93F1, 0x5BC5341E, 0x58A5F263, 0xC62E155C,
+    0x58BA7FF4, 0x5F6F845A, 0x7E36A6AD, 0x67E1F7DC,
+    0xEEAA4D04, 0xD33A7657, 0x18267E4E, 0xFF9F2322,
+    /* G + 2^52 G + 2^156 G + 2^208 G */
+    0xC7644C1D, 0xE33F0255, 0xBB9002D8, 0x4030ECC3,
+    0xF4646F9F, 0xA4486916, 0x959C44FA, 0x5E677D0C,
+    0xD88B9144, 0xE2E7D7D0, 0x6248F91F, 0x5D93A86F,
+    0x02993AEA, 0xE33D0BD5, 0x3100D31E, 0x449F0CE6,
+    /* G + 2^104 G + 2^156 G + 2^208 G */
+    0xFDAAB256, 0x52DF1588, 0x3127354C, 0x68C0CD44,
+    0xA591F853, 0x2A849471, 0x93D0CB92, 0xE4DA88E9,
+    0x1639C624, 0x6D1EA35D, 0x263707BA, 0x60FE2A36,
+    0xD0F3BC51, 0x97FC50DE, 0x10062E80, 0xF7FA4D15,
+    /* G + 2^52 G + 2^104 G + 2^156 G + 2^208 G */
+    0x5B696527, 0x2E75A266, 0x5A00169C, 0x1A2530B0,
+    0x4286FB42, 0x76C4C180, 0x8E831D5B, 0x825F0194,
+    0xEF703739, 0xDBF0A11F, 0xCE5B106A, 0x106F9BC4,
+    0x24111150, 0x61794C4F, 0xBC723A17, 0x435872FE,
+};
+#endif /* CC3XX_CONFIG_EC_CURVE_SECP_256_R1_GENERATOR_COMB_ENABLE */
+
 const cc3xx_ec_curve_data_t secp_256_r1 = {
     .type = CC3XX_EC_CURVE_TYPE_WEIERSTRASS,
     .register_size = 32,
@@ -103,10 +192,136 @@ const cc3xx_ec_curve_data_t secp_256_r1 = {
 
     .cofactor = 1,
     .recommended_bits_for_generation = 352,
+
+#ifdef CC3XX_CONFIG_EC_CURVE_SECP_256_R1_GENERATOR_COMB_ENABLE
+    .generator_comb_table = secp_256_r1_generator_comb,
+    .generator_comb_columns = 52,
+#endif /* CC3XX_CONFIG_EC_CURVE_SECP_256_R1_GENERATOR_COMB_ENABLE */
 };
 #endif
 
 #ifdef CC3XX_CONFIG_EC_CURVE_SECP_384_R1_ENABLE
+#ifdef CC3XX_CONFIG_EC_CURVE_SECP_384_R1_GENERATOR_COMB_ENABLE
+/* Multiples of the generator used by the fixed-base comb, for a comb of
+ * CC3XX_EC_GENERATOR_COMB_WIDTH rows and 77 columns. Entry i holds
+ * (1 + sum of 2^(77 * j) for each bit j - 1 set in i) * G in affine coordinates.
+ */
+static const uint32_t secp_384_r1_generator_comb[] = {
+    /* G */
+    0x72760AB7, 0x3A545E38, 0xBF55296C, 0x5502F25D,
+    0x82542A38, 0x59F741E0, 0x8BA79B98, 0x6E1D3B62,
+    0xF320AD74, 0x8EB1C71E, 0xBE8B0537, 0xAA87CA22,
+    0x90EA0E5F, 0x7A431D7C, 0x1D7E819D, 0x0A60B1CE,
+    0xB5F0B8C0, 0xE9DA3113, 0x289A147C, 0xF8F41DBD,
+    0x9292DC29, 0x5D9E98BF, 0x96262C6F, 0x3617DE4A,
+    /* G + 2^77 G */
+    0x8E8CF6BD, 0x4DF624DB, 0x8547E6B6, 0x8244132B,
+    0xEAAC9420, 0xA9D5E399, 0x21AD8066, 0x0A9B91BD,
+    0x3EEE915B, 0x492ECEBD, 0x0FDD804E, 0x5E54D953,
+    0xCC5A43B2, 0x44288C00, 0x42727FD7, 0xF66D7125,
+    0x89A66C33, 0x6F98B352, 0x95821B09, 0x5009A4B4,
+    0x0E8131D0, 0xB5E534AC, 0x4BA24BC0, 0x4A3D7763,
+    /* G + 2^154 G */
+    0x931694D6, 0x3311EC54, 0xD26C55B2, 0x66004EC3,
+    0x1F2CCD66, 0xD50A0AC4, 0x4B047385, 0x274E6260,
+    0xB7FD6664, 0xD96204E4, 0x6AA71294, 0xD23B746B,
+    0x46B64ADD, 0x9A7231A7, 0xBE780847, 0x47709B8E,
+    0xAA3AEC73, 0xC5BE101D, 0xB89D3090, 0x2786BD19,
+    0x09A71BA8, 0x5F348F1D, 0x0169076A, 0xE2F2CDA7,
+    /* G + 2^77 G + 2^154 G */
+    0x1A465EE0, 0x70CB8A4C, 0xF8EE3F37, 0xF04BA246,
+    0xC81EE126, 0xD6BEAEB6, 0xDC50393C, 0x5FC113E8,
+    0xD094B6A7, 0xD0472DD3, 0xDA1C1669, 0xB769B0BE,
+    0x4157BCA1, 0x772481FA, 0x96BEEEC6, 0xDE0AED5E,
+    0x284569C0, 0xB9C04F16, 0x8B36D601, 0xA2415911,
+    0xD415E1CA, 0x81D51B7F, 0xEBAAD0A2, 0x4FE542B9,
+    /* G + 2^231 G */
+    0xEDF8C996, 0x7FFAF718, 0xC58B999A, 0x4EE49986,
+    0xBA5328E9, 0x5FDC0C0F, 0x4DE7B0B3, 0x22BB9F3B,
+    0x79A8B5AB, 0x59BDB661, 0x5B46960B, 0xA41CEB96,
+    0x673F565B, 0xF95FD896, 0x5546575D, 0x1682F977,
+    0x725E981D, 0x985159D4, 0x82EDFF44, 0x2CFE484D,
+    0xE5EFAAD0, 0x785CB625, 0x10E28346, 0xC6E94CF8,
+    /* G + 2^77 G + 2^231 G */
+    0xB33139E7, 0x49BF609F, 0xAC820A90, 0x60FD2CEB,
+    0x164A20F6, 0xA1344AD0, 0xCED42AB2, 0xC8A16564,
+    0x87F81DB5, 0xC778EF62, 0xDA05DE0C, 0x81C02C3E,
+    0xC17D28B9, 0x924D0E64, 0x90E31340, 0x8BF310B1,
+    0xA9CE292C, 0x9DDAD413, 0xC42F9A8E, 0x46A2A12D,
+    0x69CB4B1D, 0x0C345297, 0x4C3EF2D3, 0x1CE0028A,
+    /* G + 2^154 G + 2^231 G */
+    0xB2319168, 0xF9A6E7F2, 0x51D144A0, 0xEDD5F953,
+    0xAD2AD161, 0x7171C038, 0xF7215966, 0x5C01A2BE,
+    0xB978FA06, 0xF696C756, 0x6579D248, 0x714398BB,
+    0xAB1FB325, 0x4ADE5706, 0xFF0C1846, 0x818B42B4,
+    0xD6EE937E, 0x7F0C9F34, 0x90CD7784, 0x54AC28C5,
+    0xE17F0476, 0x8701F645, 0xA4B5D7B8, 0x6545AA51,
+    /* G + 2^77 G + 2^154 G + 2^231 G */
+    0xCB38E86D, 0xE2A2F4FC, 0x5382ED59, 0xCB5357BA,
+    0x1B5076C2, 0x6BE08D5D, 0x4D83E11C, 0xC62DF637,
+    0x60969A97, 0xD6958C1E, 0x54DBFC48, 0xA49B602C,
+    0x51914BCA, 0xFB97D2EE, 0xAA211719, 0xB4BC64C9,
+    0x00644D20, 0x0ADCD952, 0xA75F0046, 0xB8E8CA59,
+    0x17A818F2, 0x9F5E1FE2, 0xB5CF54D1, 0x7E1D2F2E,
+    /* G + 2^308 G */
+    0x1E060165, 0x79FE2465, 0xB6B90F17, 0x5130BDE7,
+    0x853CB459, 0xCE254CFD, 0xBA440754, 0xA8782B8E,
+    0xDAF8AA6C, 0x7D81F68F, 0x44B8BF68, 0xAA0E19AA,
+    0x2664A487, 0x6E3EE96F, 0x4E9FEA80, 0x8F1B7D25,
+    0x131C050D, 0x7A282A2A, 0xCA81498E, 0xD986B357,
+    0x154EC895, 0xC4750753, 0xCB3C35A3, 0x65DB0B8A,
+    /* G + 2^77 G + 2^308 G */
+    0x6A570F04, 0x1D21128B, 0x394FE427, 0xE917B31C,
+    0x6BA2D13C, 0xC0FE28DE, 0x7F08EBA2, 0x2D31795F,
+    0x88492CB7, 0xDABB8957, 0xC82A64C1, 0x5B6478B4,
+    0xCD430E4C, 0x5D14F518, 0x217D14F8, 0x552992D1,
+    0x95033367, 0xB38D3C11, 0xAE07E0E5, 0xACBB2DDC,
+    0x7B50F818, 0x7093124C, 0x7E9CC15B, 0x0AE3337F,
+    /* G + 2^154 G + 2^308 G */
+    0xEB3F72ED, 0xB8566746, 0x08E114AE, 0x53316ED1,
+    0x91AEA8C6, 0x45E5B481, 0x2857A9D5, 0x73C30BF5,
+    0xFD1F7C82, 0x26DB96AF, 0xDF1822B5, 0x8C9010D0,
+    0x20428D3D, 0x246624AB, 0x6A02C7CD, 0xA3A48C9F,
+    0x34CD1BDD, 0x1298B738, 0x1B71B3BD, 0x664833BC,
+    0x070A6E08, 0xD9365CD7, 0xD610B66B, 0xA44AD979,
+    /* G + 2^77 G + 2^154 G + 2^308 G */
+    0x6F824A23, 0xA651A249, 0xBC1B0886, 0xABA60A2B,
+    0x67E331A8, 0xC632EF51, 0xD3432743, 0x386CAB94,
+    0x24DBDACC, 0x644657CD, 0xEA9D8EEB, 0x79BAEFE3,
+    0x7C0022A9, 0xCE100B59, 0xB5552550, 0xC72C67D5,
+    0xC625D47F, 0xCC7C468D, 0x43B94872, 0x54376AE2,
+    0xFD91B733, 0x86116D31, 0xC07AB981, 0xC33E942E,
+    /* G + 2^231 G + 2^308 G */
+    0xDC9BB565, 0x5026D3E0, 0xA41DAC8D, 0x3A345564,
+    0xCF05440B, 0x092B8073, 0xE7E95F9A, 0xDE1F971D,
+    0xBCB04838, 0x177D47C6, 0x37393D29, 0xB2A0C449,
+    0xE77340CD, 0x00224C3D, 0x6A4E526E, 0x31E37B98,
+    0xBC55A51B, 0xEE98B785, 0x091BC664, 0x4ED22126,
+    0x98C7090F, 0x59C178BA, 0xA14CE4D5, 0x597FC7F4,
+    /* G + 2^77 G + 2^231 G + 2^308 G */
+    0xFEDF311D, 0x00F305D9, 0x6082A9F9, 0x2322592A,
+    0xDFC76F75, 0xF1841C28, 0x10AF674E, 0xF0714D17,
+    0xAF895173, 0xCD871803, 0x94F5571C, 0x110AB6A9,
+    0x22D4D124, 0x5AA3B421, 0xA2FE7A5F, 0xCB6EB594,
+    0xB6B4AC39, 0xBBE918BA, 0x3A31C961, 0x19E5161E,
+    0x3FFFC9CD, 0xC2A7A2CB, 0xC67BBAA3, 0x1A0825B1,
+    /* G + 2^154 G + 2^231 G + 2^308 G */
+    0x77E930E1, 0x3D4100E8, 0xADC4C838, 0x0899BAAD,
+    0xF6B3097E, 0x5B64899F, 0x2790439D, 0x7C060A89,
+    0x513497C6, 0x40AB25D0, 0x202D8833, 0xDFA74FE2,
+    0x2466F95B, 0x689CCEC5, 0xE0B8E88E, 0xE757107A,
+    0x56A78F16, 0x38D0D513, 0x5DA9F7C2, 0x47C8301C,
+    0x31956F2B, 0xE8C55CC6, 0x0C8D4931, 0x6DA590D6,
+    /* G + 2^77 G + 2^154 G + 2^231 G + 2^308 G */
+    0x679A2ABA, 0x96EDF50F, 0x7FA01880, 0x31B92B91,
+    0x72495766, 0xFDA047EB, 0xCB1299C9, 0xE8C663C5,
+    0x91DBE668, 0x15798146, 0x9DA9121C, 0x25E209C5,
+    0xF69B64DA, 0x9AD033A2, 0xD82ADB97, 0x6366E8F3,
+    0xE9103189, 0x96052F28, 0x6E6CE744, 0x6C279054,
+    0xFE5D6697, 0xDA53B069, 0xDA09FB6A, 0x553200B9,
+};
+#endif /* CC3XX_CONFIG_EC_CURVE_SECP_384_R1_GENERATOR_COMB_ENABLE */
+
 const cc3xx_ec_curve_data_t secp_384_r1 = {
     .type = CC3XX_EC_CURVE_TYPE_WEIERSTRASS,
     .register_size = 48,
@@ -140,6 +355,11 @@ const cc3xx_ec_curve_data_t secp_384_r1 = {
 
     .cofactor = 1,
     .recommended_bits_for_generation = 384,
+
+#ifdef CC3XX_CONFIG_EC_CURVE_SECP_384_R1_GENERATOR_COMB_ENABLE
+    .generator_comb_table = secp_384_r1_generator_comb,
+    .generator_comb_columns = 77,
+#endif /* CC3XX_CONFIG_EC_CURVE_SECP_384_R1_GENERATOR_COMB_ENABLE */
 };
 #endif
 
@@ -17,6 +17,7 @@
 
 #include <assert.h>
 
+#include "cc3xx_stdlib.h"
 #include "fatal_error.h"
 
 #if defined(CC3XX_CONFIG_ECDSA_VERIFY_ENABLE)     \
@@ -452,6 +453,231 @@ static cc3xx_err_t multiply_point_by_scalar_side_channel_protected(
 
     return err;
 }
+
+#ifdef CC3XX_EC_GENERATOR_COMB_ENABLE
+#define GENERATOR_COMB_TABLE_SIZE (1 << (CC3XX_EC_GENERATOR_COMB_WIDTH - 1))
+#define GENERATOR_COMB_MAX_COLUMNS \
+    ((CC3XX_EC_MAX_POINT_SIZE * 8 + CC3XX_EC_GENERATOR_COMB_WIDTH - 1) \
+     / CC3XX_EC_GENERATOR_COMB_WIDTH)
+/* Set in a recoded comb digit if the table point must be negated */
+#define GENERATOR_COMB_DIGIT_NEGATIVE (0x80)
+
+/* Loads an entry of the generator comb table into PKA registers. Every entry is
+ * read, so that the memory access pattern doesn't depend on the index.
+ */
+static void generator_comb_load_point(const cc3xx_ec_curve_data_t *curve_data,
+                                      uint32_t table_idx,
+                                      cc3xx_ec_point_affine *res)
+{
+    const size_t coord_words = curve_data->modulus_size / sizeof(uint32_t);
+    uint32_t point[2 * CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)] = {0};
+    uint32_t entry;
+    uint32_t mask;
+    size_t word;
+
+    for (entry = 0; entry < GENERATOR_COMB_TABLE_SIZE; entry++) {
+        /* All ones for the requested entry, all zeroes otherwise */
+        mask = 0U - (((entry ^ table_idx) - 1U) >> 31);
+
+        for (word = 0; word < 2 * coord_words; word++) {
+            point[word] |= curve_data->generator_comb_table[entry * 2 * coord_words + word]
+                           & mask;
+        }
+    }
+
+    cc3xx_lowlevel_pka_write_reg(res->x, point, curve_data->modulus_size);
+    cc3xx_lowlevel_pka_write_reg(res->y, point + coord_words,
+                                 curve_data->modulus_size);
+
+    cc3xx_secure_erase_buffer(point, 2 * coord_words);
+}
+
+/* Sets res to the table point selected by a recoded comb digit. The negation is
+ * always computed, and the sign only selects which register is used.
+ */
+static void generator_comb_select_point(const cc3xx_ec_curve_data_t *curve_data,
+                                        uint32_t digit,
+                                        cc3xx_ec_point_affine *table_point,
+                                        cc3xx_pka_reg_id_t neg_y,
+                                        cc3xx_ec_point_affine *res)
+{
+    cc3xx_pka_reg_id_t y_select[2] = { table_point->y, neg_y };
+
+    generator_comb_load_point(curve_data,
+                              (digit & ~GENERATOR_COMB_DIGIT_NEGATIVE) >> 1,
+                              table_point);
+    cc3xx_lowlevel_pka_mod_neg(table_point->y, neg_y);
+
+    res->x = table_point->x;
+    res->y = y_select[(digit & GENERATOR_COMB_DIGIT_NEGATIVE) != 0];
+}
+
+/* Computes the comb digits of an odd scalar, recoded so that every digit is odd
+ * and so selects a non-zero table point with a sign. This avoids additions of
+ * the point at infinity, which would not be constant time. The recoding is the
+ * one used by the Mbed TLS fixed-point comb.
+ */
+static void generator_comb_recode_scalar(cc3xx_pka_reg_id_t scalar,
+                                         size_t columns, uint32_t *digits)
+{
+    const uint32_t scalar_bit_size = cc3xx_lowlevel_pka_get_bit_size(scalar);
+    uint32_t bit_idx;
+    uint32_t carry = 0;
+    uint32_t next_carry;
+    uint32_t adjust;
+    size_t idx;
+    size_t row;
+
+    for (idx = 0; idx < columns; idx++) {
+        digits[idx] = 0;
+        for (row = 0; row < CC3XX_EC_GENERATOR_COMB_WIDTH; row++) {
+            bit_idx = idx + row * columns;
+            if (bit_idx < scalar_bit_size) {
+                digits[idx] |= cc3xx_lowlevel_pka_test_bits_ui(scalar, bit_idx, 1)
+                               << row;
+            }
+        }
+    }
+    digits[columns] = 0;
+
+    /* Make digits 1 to columns odd, digit 0 being odd as the scalar is */
+    for (idx = 1; idx <= columns; idx++) {
+        next_carry = digits[idx] & carry;
+        digits[idx] ^= carry;
+        carry = next_carry;
+
+        adjust = 1 - (digits[idx] & 1);
+        carry |= digits[idx] & (digits[idx - 1] * adjust);
+        digits[idx] ^= digits[idx - 1] * adjust;
+        digits[idx - 1] |= adjust * GENERATOR_COMB_DIGIT_NEGATIVE;
+    }
+}
+
+static cc3xx_err_t multiply_generator_by_scalar_comb(
+                                             cc3xx_ec_curve_t *curve,
+                                             const cc3xx_ec_curve_data_t *curve_data,
+                                             cc3xx_pka_reg_id_t scalar,
+                                             cc3xx_ec_point_affine *res)
+{
+    const size_t columns = curve_data->generator_comb_columns;
+    uint32_t digits[GENERATOR_COMB_MAX_COLUMNS + 1];
+    uint32_t scalar_is_even;
+    int32_t idx;
+    cc3xx_err_t err = CC3XX_ERR_SUCCESS;
+
+    cc3xx_pka_reg_id_t odd_scalar;
+    cc3xx_pka_reg_id_t neg_y;
+    cc3xx_ec_point_affine table_point;
+    cc3xx_ec_point_affine selected_point;
+    cc3xx_ec_point_projective proj_selected_point;
+    cc3xx_ec_point_projective accumulator;
+    cc3xx_ec_point_projective final_accumulator;
+    cc3xx_ec_point_projective *accumulator_select[2] = {
+        &accumulator, &final_accumulator,
+    };
+
+    assert(columns <= GENERATOR_COMB_MAX_COLUMNS);
+
+    /* The recoding needs an odd scalar, so if the scalar is even (s + 1) * G is
+     * computed and G is subtracted at the end. The odd scalar is only needed
+     * for the recoding, and registers are freed in reverse allocation order,
+     * so it is allocated and freed before any of the other registers.
+     */
+    odd_scalar = cc3xx_lowlevel_pka_allocate_reg();
+
+    scalar_is_even = 1 - cc3xx_lowlevel_pka_test_bits_ui(scalar, 0, 1);
+    cc3xx_lowlevel_pka_add_si(scalar, scalar_is_even, odd_scalar);
+
+    generator_comb_recode_scalar(odd_scalar, columns, digits);
+
+    cc3xx_lowlevel_pka_free_reg(odd_scalar);
+
+    neg_y = cc3xx_lowlevel_pka_allocate_reg();
+    table_point = cc3xx_lowlevel_ec_allocate_point();
+    accumulator = cc3xx_lowlevel_ec_allocate_projective_point();
+    final_accumulator = cc3xx_lowlevel_ec_allocate_projective_point();
+
+    /* The table points all have Z = 1, so they can be added as mixed points */
+    proj_selected_point.z = cc3xx_lowlevel_pka_allocate_reg();
+    cc3xx_lowlevel_pka_clear(proj_selected_point.z);
+    cc3xx_lowlevel_pka_add_si(proj_selected_point.z, 1, proj_selected_point.z);
+
+    /* The accumulator starts with a random Z, as in the generic multiplication */
+    generator_comb_select_point(curve_data, digits[columns], &table_point, neg_y,
+                                &selected_point);
+    cc3xx_lowlevel_ec_affine_to_jacobian_with_random_z(curve, &selected_point,
+                                                       &accumulator);
+
+    for (idx = columns - 1; idx >= 0; idx--) {
+        double_point(curve, &accumulator, &accumulator);
+
+        generator_comb_select_point(curve_data, digits[idx], &table_point, neg_y,
+                                    &selected_point);
+        proj_selected_point.x = selected_point.x;
+        proj_selected_point.y = selected_point.y;
+
+        add_points(curve, &accumulator, &proj_selected_point, &accumulator);
+
+        if (cc3xx_lowlevel_ec_projective_point_is_infinity(&accumulator)) {
+            FATAL_ERR(CC3XX_ERR_EC_POINT_IS_INFINITY);
+            err |= CC3XX_ERR_EC_POINT_IS_INFINITY;
+        }
+    }
+
+    /* Always compute the result minus G, so the time doesn't depend on whether
+     * the scalar was adjusted.
+     */
+    generator_comb_select_point(curve_data, 1 | GENERATOR_COMB_DIGIT_NEGATIVE,
+                                &table_point, neg_y, &selected_point);
+    proj_selected_point.x = selected_point.x;
+    proj_selected_point.y = selected_point.y;
+    add_points(curve, &accumulator, &proj_selected_point, &final_accumulator);
+
+    err |= cc3xx_lowlevel_ec_jacobian_to_affine(curve,
+                                                accumulator_select[scalar_is_even],
+                                                res);
+
+    if (err != CC3XX_ERR_SUCCESS) {
+        cc3xx_lowlevel_pka_clear(res->x);
+        cc3xx_lowlevel_pka_clear(res->y);
+    }
+
+    cc3xx_secure_erase_buffer(digits, columns + 1);
+
+    cc3xx_lowlevel_pka_free_reg(proj_selected_point.z);
+    cc3xx_lowlevel_ec_free_projective_point(&final_accumulator);
+    cc3xx_lowlevel_ec_free_projective_point(&accumulator);
+    cc3xx_lowlevel_ec_free_point(&table_point);
+    cc3xx_lowlevel_pka_free_reg(neg_y);
+
+    cc3xx_lowlevel_pka_unmap_physical_registers();
+
+    return err;
+}
+#endif /* CC3XX_EC_GENERATOR_COMB_ENABLE */
+
+static cc3xx_err_t multiply_point_by_scalar_protected(cc3xx_ec_curve_t *curve,
+                                                      cc3xx_ec_point_affine *p,
+                                                      cc3xx_pka_reg_id_t scalar,
+                                                      cc3xx_ec_point_affine *res)
+{
+#ifdef CC3XX_EC_GENERATOR_COMB_ENABLE
+    const cc3xx_ec_curve_data_t *curve_data = cc3xx_lowlevel_ec_get_curve_data(curve->id);
+
+    /* Multiplications of the generator use the precomputed comb if the curve
+     * has one, and if the scalar fits in it. The scalar size is already
+     * observable through the duration of the generic multiplication.
+     */
+    if (p->x == curve->generator.x && p->y == curve->generator.y
+        && curve_data->generator_comb_table != NULL
+        && cc3xx_lowlevel_pka_get_bit_size(scalar)
+           <= CC3XX_EC_GENERATOR_COMB_WIDTH * curve_data->generator_comb_columns) {
+        return multiply_generator_by_scalar_comb(curve, curve_data, scalar, res);
+    }
+#endif /* CC3XX_EC_GENERATOR_COMB_ENABLE */
+
+    return multiply_point_by_scalar_side_channel_protected(curve, p, scalar, res);
+}
 #endif /* !CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE */
 
 #if defined(CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE)
@@ -558,7 +784,7 @@ cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_multiply_point_by_scalar(
     cc3xx_lowlevel_pka_free_reg(zero_reg);
     return err;
 #else
-    return multiply_point_by_scalar_side_channel_protected(curve, p, scalar, res);
+    return multiply_point_by_scalar_protected(curve, p, scalar, res);
 #endif
 }
 
@@ -578,10 +804,8 @@ cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_shamir_multiply_points_by_scalars_and_
     cc3xx_err_t err = CC3XX_ERR_SUCCESS;
     cc3xx_ec_point_affine temp_point = cc3xx_lowlevel_ec_allocate_point();
 
-    err |= multiply_point_by_scalar_side_channel_protected(curve, p1, scalar1,
-                                                           &temp_point);
-    err |= multiply_point_by_scalar_side_channel_protected(curve, p2, scalar2,
-                                                           res);
+    err |= multiply_point_by_scalar_protected(curve, p1, scalar1, &temp_point);
+    err |= multiply_point_by_scalar_protected(curve, p2, scalar2, res);
     err |= cc3xx_lowlevel_ec_add_points(curve, &temp_point, res, res);
 
     cc3xx_lowlevel_ec_free_point(&temp_point);
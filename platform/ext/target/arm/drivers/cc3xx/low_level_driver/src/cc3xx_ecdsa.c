@@ -16,6 +16,7 @@
 #include CC3XX_CONFIG_FILE
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -247,56 +248,33 @@ out:
 #endif /* CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE */
 
 #ifdef CC3XX_CONFIG_ECDSA_VERIFY_ENABLE
-/* As per NIST FIPS 186-5 section 6.4.2.
- */
-cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
-                                        const uint32_t *public_key_x,
-                                        size_t public_key_x_len,
-                                        const uint32_t *public_key_y,
-                                        size_t public_key_y_len,
-                                        const uint32_t *hash, size_t hash_len,
-                                        const uint32_t *sig_r, size_t sig_r_len,
-                                        const uint32_t *sig_s, size_t sig_s_len)
+static cc3xx_err_t check_verify_input_sizes(cc3xx_ec_curve_t *curve,
+                                            size_t public_key_x_len,
+                                            size_t public_key_y_len,
+                                            size_t hash_len,
+                                            size_t sig_r_len,
+                                            size_t sig_s_len)
 {
-    cc3xx_ec_curve_t curve;
-    cc3xx_ec_point_affine public_key_point;
-    cc3xx_ec_point_affine calculated_r_point;
-    cc3xx_pka_reg_id_t sig_s_reg;
-    cc3xx_pka_reg_id_t sig_r_reg;
-    cc3xx_pka_reg_id_t u_reg;
-    cc3xx_pka_reg_id_t v_reg;
-    cc3xx_pka_reg_id_t hash_reg;
-    cc3xx_err_t err;
     struct cc3xx_pka_state_t pka_state;
 
-    /* This sets up various curve parameters into PKA registers */
-    err = cc3xx_lowlevel_ec_init(curve_id, &curve);
-    if (err != CC3XX_ERR_SUCCESS) {
-        goto out;
-    }
-
-    if (public_key_x_len > curve.modulus_size) {
+    if (public_key_x_len > curve->modulus_size) {
         FATAL_ERR(CC3XX_ERR_ECDSA_INVALID_KEY);
-        err = CC3XX_ERR_ECDSA_INVALID_KEY;
-        goto out;
+        return CC3XX_ERR_ECDSA_INVALID_KEY;
     }
 
-    if (public_key_y_len > curve.modulus_size) {
+    if (public_key_y_len > curve->modulus_size) {
         FATAL_ERR(CC3XX_ERR_ECDSA_INVALID_KEY);
-        err = CC3XX_ERR_ECDSA_INVALID_KEY;
-        goto out;
+        return CC3XX_ERR_ECDSA_INVALID_KEY;
     }
 
-    if (sig_r_len > curve.modulus_size) {
+    if (sig_r_len > curve->modulus_size) {
         FATAL_ERR(CC3XX_ERR_ECDSA_SIGNATURE_INVALID);
-        err = CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
-        goto out;
+        return CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
     }
 
-    if (sig_s_len > curve.modulus_size) {
+    if (sig_s_len > curve->modulus_size) {
         FATAL_ERR(CC3XX_ERR_ECDSA_SIGNATURE_INVALID);
-        err = CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
-        goto out;
+        return CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
     }
 
     /* The hash _can_ be larger than the modulus, but must still fit into the
@@ -305,11 +283,31 @@ cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
     cc3xx_lowlevel_pka_get_state(&pka_state, 0, NULL, NULL, NULL);
     if (hash_len > pka_state.reg_size) {
         FATAL_ERR(CC3XX_ERR_ECDSA_INVALID_HASH);
-        err = CC3XX_ERR_ECDSA_INVALID_HASH;
-        goto out;
+        return CC3XX_ERR_ECDSA_INVALID_HASH;
     }
 
-    /* Now that PKA is initialized, allocate the registers / points we'll use */
+    return CC3XX_ERR_SUCCESS;
+}
+
+/* As per NIST FIPS 186-5 section 6.4.2. Requires the curve to be set up with
+ * cc3xx_lowlevel_ec_init and the public key to have been loaded and validated.
+ * All the PKA registers allocated here are freed before returning, so that this
+ * can be called repeatedly on the same curve.
+ */
+static cc3xx_err_t verify_with_public_key_point(cc3xx_ec_curve_t *curve,
+                                        cc3xx_ec_point_affine *public_key_point,
+                                        const uint32_t *hash, size_t hash_len,
+                                        const uint32_t *sig_r, size_t sig_r_len,
+                                        const uint32_t *sig_s, size_t sig_s_len)
+{
+    cc3xx_ec_point_affine calculated_r_point;
+    cc3xx_pka_reg_id_t sig_s_reg;
+    cc3xx_pka_reg_id_t sig_r_reg;
+    cc3xx_pka_reg_id_t u_reg;
+    cc3xx_pka_reg_id_t v_reg;
+    cc3xx_pka_reg_id_t hash_reg;
+    cc3xx_err_t err;
+
     sig_r_reg = cc3xx_lowlevel_pka_allocate_reg();
     sig_s_reg = cc3xx_lowlevel_pka_allocate_reg();
     u_reg = cc3xx_lowlevel_pka_allocate_reg();
@@ -318,20 +316,6 @@ cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
 
     calculated_r_point = cc3xx_lowlevel_ec_allocate_point();
 
-
-    /* This validates that the public key point lies on the curve, is not the
-     * identity element, and that it multiplied by the group order is infinity.
-     */
-    err = cc3xx_lowlevel_ec_allocate_point_from_data(&curve,
-                                            public_key_x, public_key_x_len,
-                                            public_key_y, public_key_y_len,
-                                            &public_key_point);
-    if (err != CC3XX_ERR_SUCCESS) {
-        FATAL_ERR(CC3XX_ERR_ECDSA_SIGNATURE_INVALID);
-        err = CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
-        goto out;
-    }
-
     cc3xx_lowlevel_pka_write_reg_swap_endian(sig_s_reg, sig_s, sig_s_len);
     /* Check that s is less than N */
     if (!cc3xx_lowlevel_pka_less_than(sig_s_reg, CC3XX_PKA_REG_N)) {
@@ -370,9 +354,9 @@ cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
     /* If the size of the hash is greater than the group order, reduce the amount of
      * bits used by shifting.
      */
-    if (hash_len > curve.modulus_size) {
+    if (hash_len > curve->modulus_size) {
         cc3xx_lowlevel_pka_shift_right_fill_0_ui(hash_reg,
-                                                 (hash_len - curve.modulus_size) * 8,
+                                                 (hash_len - curve->modulus_size) * 8,
                                                  hash_reg);
     }
     /* Then finally a reduction so we can be sure the hash is below N */
@@ -387,10 +371,15 @@ cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
     /* v = r * s^-1 */
     cc3xx_lowlevel_pka_mod_mul(v_reg, sig_r_reg, v_reg);
 
-    /* R1 = [u]G + [v]Q */
-    err = cc3xx_lowlevel_ec_shamir_multiply_points_by_scalars_and_add(&curve,
-                                                      &curve.generator, u_reg,
-                                                      &public_key_point, v_reg,
+    /* R1 = [u]G + [v]Q. Without CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE, [u]G is
+     * computed with the generator comb, if the curve has one. With it, the
+     * comb isn't used: the joint ladder shares its doublings between both
+     * scalars, which is cheaper than the comb plus a separate full-length
+     * multiplication of Q.
+     */
+    err = cc3xx_lowlevel_ec_shamir_multiply_points_by_scalars_and_add(curve,
+                                                      &curve->generator, u_reg,
+                                                      public_key_point, v_reg,
                                                       &calculated_r_point);
     if (err != CC3XX_ERR_SUCCESS) {
         FATAL_ERR(CC3XX_ERR_ECDSA_SIGNATURE_INVALID);
@@ -408,6 +397,157 @@ cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
         err = CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
     }
 
+out:
+    cc3xx_lowlevel_ec_free_point(&calculated_r_point);
+    cc3xx_lowlevel_pka_free_reg(hash_reg);
+    cc3xx_lowlevel_pka_free_reg(v_reg);
+    cc3xx_lowlevel_pka_free_reg(u_reg);
+    cc3xx_lowlevel_pka_free_reg(sig_s_reg);
+    cc3xx_lowlevel_pka_free_reg(sig_r_reg);
+
+    return err;
+}
+
+cc3xx_err_t cc3xx_lowlevel_ecdsa_verify(cc3xx_ec_curve_id_t curve_id,
+                                        const uint32_t *public_key_x,
+                                        size_t public_key_x_len,
+                                        const uint32_t *public_key_y,
+                                        size_t public_key_y_len,
+                                        const uint32_t *hash, size_t hash_len,
+                                        const uint32_t *sig_r, size_t sig_r_len,
+                                        const uint32_t *sig_s, size_t sig_s_len)
+{
+    cc3xx_ec_curve_t curve;
+    cc3xx_ec_point_affine public_key_point;
+    cc3xx_err_t err;
+
+    /* This sets up various curve parameters into PKA registers */
+    err = cc3xx_lowlevel_ec_init(curve_id, &curve);
+    if (err != CC3XX_ERR_SUCCESS) {
+        goto out;
+    }
+
+    err = check_verify_input_sizes(&curve, public_key_x_len, public_key_y_len,
+                                   hash_len, sig_r_len, sig_s_len);
+    if (err != CC3XX_ERR_SUCCESS) {
+        goto out;
+    }
+
+    /* This validates that the public key point lies on the curve, is not the
+     * identity element, and that it multiplied by the group order is infinity.
+     */
+    err = cc3xx_lowlevel_ec_allocate_point_from_data(&curve,
+                                            public_key_x, public_key_x_len,
+                                            public_key_y, public_key_y_len,
+                                            &public_key_point);
+    if (err != CC3XX_ERR_SUCCESS) {
+        FATAL_ERR(CC3XX_ERR_ECDSA_SIGNATURE_INVALID);
+        err = CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
+        goto out;
+    }
+
+    err = verify_with_public_key_point(&curve, &public_key_point,
+                                       hash, hash_len,
+                                       sig_r, sig_r_len,
+                                       sig_s, sig_s_len);
+
+out:
+    /* This frees all the PKA registers as it will deinit the PKA engine */
+    cc3xx_lowlevel_ec_uninit();
+
+    return err;
+}
+
+static bool public_keys_are_same(const struct cc3xx_ecdsa_verify_batch_entry_t *a,
+                                 const struct cc3xx_ecdsa_verify_batch_entry_t *b)
+{
+    return a->public_key_x == b->public_key_x
+        && a->public_key_x_len == b->public_key_x_len
+        && a->public_key_y == b->public_key_y
+        && a->public_key_y_len == b->public_key_y_len;
+}
+
+cc3xx_err_t cc3xx_lowlevel_ecdsa_verify_batch(cc3xx_ec_curve_id_t curve_id,
+                        const struct cc3xx_ecdsa_verify_batch_entry_t *entries,
+                        size_t entry_amount,
+                        cc3xx_err_t *results)
+{
+    cc3xx_ec_curve_t curve;
+    cc3xx_ec_point_affine public_key_point;
+    const struct cc3xx_ecdsa_verify_batch_entry_t *loaded_key_entry = NULL;
+    cc3xx_err_t key_err = CC3XX_ERR_SUCCESS;
+    cc3xx_err_t batch_err = CC3XX_ERR_SUCCESS;
+    cc3xx_err_t err;
+    size_t idx;
+
+    /* The curve parameters, the generator and the Barrett tags are loaded once
+     * and stay in the PKA registers for the whole batch.
+     */
+    err = cc3xx_lowlevel_ec_init(curve_id, &curve);
+    if (err != CC3XX_ERR_SUCCESS) {
+        for (idx = 0; results != NULL && idx < entry_amount; idx++) {
+            results[idx] = err;
+        }
+        goto out;
+    }
+
+    for (idx = 0; idx < entry_amount; idx++) {
+        const struct cc3xx_ecdsa_verify_batch_entry_t *entry = &entries[idx];
+
+        err = check_verify_input_sizes(&curve, entry->public_key_x_len,
+                                       entry->public_key_y_len,
+                                       entry->hash_len, entry->sig_r_len,
+                                       entry->sig_s_len);
+        if (err != CC3XX_ERR_SUCCESS) {
+            goto next_entry;
+        }
+
+        /* Loading the public key includes validating the point, which costs
+         * a scalar multiplication, so it is kept for as long as consecutive
+         * entries use the same key.
+         */
+        if (loaded_key_entry == NULL
+            || !public_keys_are_same(loaded_key_entry, entry)) {
+            if (loaded_key_entry != NULL) {
+                cc3xx_lowlevel_ec_free_point(&public_key_point);
+            }
+
+            key_err = cc3xx_lowlevel_ec_allocate_point_from_data(&curve,
+                                        entry->public_key_x,
+                                        entry->public_key_x_len,
+                                        entry->public_key_y,
+                                        entry->public_key_y_len,
+                                        &public_key_point);
+            loaded_key_entry = entry;
+        }
+
+        if (key_err != CC3XX_ERR_SUCCESS) {
+            FATAL_ERR(CC3XX_ERR_ECDSA_SIGNATURE_INVALID);
+            err = CC3XX_ERR_ECDSA_SIGNATURE_INVALID;
+            goto next_entry;
+        }
+
+        err = verify_with_public_key_point(&curve, &public_key_point,
+                                           entry->hash, entry->hash_len,
+                                           entry->sig_r, entry->sig_r_len,
+                                           entry->sig_s, entry->sig_s_len);
+
+next_entry:
+        if (results != NULL) {
+            results[idx] = err;
+        }
+
+        if (err != CC3XX_ERR_SUCCESS) {
+            batch_err = err;
+            if (results == NULL) {
+                /* Nobody can tell which entry failed, so stop early */
+                break;
+            }
+        }
+    }
+
+    err = batch_err;
+
 out:
     /* This frees all the PKA registers as it will deinit the PKA engine */
     cc3xx_lowlevel_ec_uninit();
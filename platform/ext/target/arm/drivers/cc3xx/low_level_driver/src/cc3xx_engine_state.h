@@ -22,6 +22,7 @@ enum cc3xx_engine_t {
     CC3XX_ENGINE_AES_TO_HASH          = 0b00010U,
     CC3XX_ENGINE_AES_AND_HASH         = 0b00011U,
     CC3XX_ENGINE_HASH                 = 0b00111U,
+    CC3XX_ENGINE_HASH_AND_BYPASS      = 0b01000U,
     CC3XX_ENGINE_AES_MAC_AND_BYPASS   = 0b01001U,
     CC3XX_ENGINE_AES_TO_HASH_AND_DOUT = 0b01010U,
     CC3XX_ENGINE_CHACHA               = 0b10000U,
@@ -40,6 +40,14 @@ static const uint32_t iv_sha1[5] = {
 };
 #endif /* CC3XX_CONFIG_HASH_SHA1_ENABLE */
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+/* The saved state which is currently loaded into the engine, and whose
+ * contents are therefore stale until it is evicted.
+ */
+static struct cc3xx_hash_state_t *resident_state;
+static struct cc3xx_hash_residency_stats_t residency_stats;
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
 static void set_hash_h(const uint32_t *buf, size_t length)
 {
     int32_t idx;
@@ -127,6 +135,11 @@ cc3xx_err_t cc3xx_lowlevel_hash_init(cc3xx_hash_alg_t alg)
 void cc3xx_lowlevel_hash_uninit(void)
 {
     static const uint32_t zero_buf[9] = {0};
+
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_evict_resident_state();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
     cc3xx_lowlevel_dma_uninit();
 
     set_hash_h(zero_buf, sizeof(zero_buf));
@@ -147,6 +160,86 @@ cc3xx_err_t cc3xx_lowlevel_hash_update(const uint8_t *buf, size_t length)
     return cc3xx_lowlevel_dma_buffered_input_data(buf, length, false);
 }
 
+#ifdef CC3XX_CONFIG_HASH_AND_BYPASS_ENABLE
+cc3xx_err_t cc3xx_lowlevel_hash_update_and_copy(const uint8_t *buf, size_t length,
+                                                uint8_t *out)
+{
+    cc3xx_err_t err;
+    size_t head_length = 0;
+    size_t fused_length;
+
+    /* If there is a partial block buffered, then top it up. This data (and
+     * only this data) is copied by the CPU, so that the block buffer only ever
+     * contains data which doesn't need to be output.
+     */
+    if (dma_state.block_buf_size_in_use != 0) {
+        head_length = dma_state.block_buf_size - dma_state.block_buf_size_in_use;
+        head_length = length < head_length ? length : head_length;
+
+        memcpy(out, buf, head_length);
+        err = cc3xx_lowlevel_dma_buffered_input_data(buf, head_length, false);
+        if (err != CC3XX_ERR_SUCCESS) {
+            return err;
+        }
+
+        buf += head_length;
+        out += head_length;
+        length -= head_length;
+    }
+
+    if (length == 0) {
+        return CC3XX_ERR_SUCCESS;
+    }
+
+    /* There is more data, so the block buffer is not the last block and can
+     * be input to the hash engine before the flow is changed.
+     */
+    cc3xx_lowlevel_dma_flush_buffer(false);
+
+    /* Always leave some data to be buffered, as the last block is needed by
+     * cc3xx_lowlevel_hash_finish to perform the padding.
+     */
+    fused_length = ((length - 1) / dma_state.block_buf_size) * dma_state.block_buf_size;
+
+    if (fused_length > 0) {
+        cc3xx_lowlevel_set_engine(CC3XX_ENGINE_HASH_AND_BYPASS);
+
+        cc3xx_lowlevel_dma_set_output(out, fused_length);
+        err = cc3xx_lowlevel_dma_buffered_input_data(buf, fused_length, true);
+        if (err == CC3XX_ERR_SUCCESS) {
+            /* The input length is a whole amount of blocks, so nothing
+             * partial is left in the block buffer after this.
+             */
+            cc3xx_lowlevel_dma_flush_buffer(false);
+        }
+
+        cc3xx_lowlevel_set_engine(CC3XX_ENGINE_HASH);
+
+        if (err != CC3XX_ERR_SUCCESS) {
+            return err;
+        }
+
+        buf += fused_length;
+        out += fused_length;
+        length -= fused_length;
+    }
+
+    memcpy(out, buf, length);
+    return cc3xx_lowlevel_dma_buffered_input_data(buf, length, false);
+}
+#else
+cc3xx_err_t cc3xx_lowlevel_hash_update_and_copy(const uint8_t *buf, size_t length,
+                                                uint8_t *out)
+{
+    /* Copy first and hash the copy, so that the hash is over exactly the data
+     * that has been output.
+     */
+    memcpy(out, buf, length);
+
+    return cc3xx_lowlevel_dma_buffered_input_data(out, length, false);
+}
+#endif /* CC3XX_CONFIG_HASH_AND_BYPASS_ENABLE */
+
 void cc3xx_lowlevel_hash_get_state(struct cc3xx_hash_state_t *state)
 {
     state->curr_len = P_CC3XX->hash.hash_cur_len[0];
@@ -159,10 +252,15 @@ void cc3xx_lowlevel_hash_get_state(struct cc3xx_hash_state_t *state)
 
 void cc3xx_lowlevel_hash_set_state(const struct cc3xx_hash_state_t *state)
 {
-    init_without_iv_set(state->alg);
     size_t hash_h_len = state->alg != CC3XX_HASH_ALG_SHA1 ? SHA256_OUTPUT_SIZE
                                                           : SHA1_OUTPUT_SIZE;
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_evict_resident_state();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
+    init_without_iv_set(state->alg);
+
     P_CC3XX->hash.hash_cur_len[0] = (uint32_t)state->curr_len;
     P_CC3XX->hash.hash_cur_len[1] = (uint32_t)(state->curr_len >> 32);
 
@@ -170,6 +268,59 @@ void cc3xx_lowlevel_hash_set_state(const struct cc3xx_hash_state_t *state)
     memcpy(&dma_state, &state->dma_state, sizeof(dma_state));
 }
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+void cc3xx_lowlevel_hash_acquire_state(struct cc3xx_hash_state_t *state)
+{
+    if (resident_state == state) {
+        residency_stats.hits++;
+        return;
+    }
+
+    /* This saves the previously resident state, if there is one */
+    cc3xx_lowlevel_hash_set_state(state);
+
+    resident_state = state;
+    residency_stats.restores++;
+}
+
+void cc3xx_lowlevel_hash_release_state(const struct cc3xx_hash_state_t *state)
+{
+    if (resident_state == state) {
+        /* Drop the state first so that the uninit doesn't save it */
+        resident_state = NULL;
+        cc3xx_lowlevel_hash_uninit();
+    }
+}
+
+void cc3xx_lowlevel_hash_evict_resident_state(void)
+{
+    struct cc3xx_hash_state_t *state = resident_state;
+
+    if (state == NULL) {
+        return;
+    }
+
+    /* Clear this first, as the uninit calls back into this function */
+    resident_state = NULL;
+
+    cc3xx_lowlevel_hash_get_state(state);
+    residency_stats.saves++;
+
+    cc3xx_lowlevel_hash_uninit();
+}
+
+void cc3xx_lowlevel_hash_get_residency_stats(
+    struct cc3xx_hash_residency_stats_t *stats)
+{
+    memcpy(stats, &residency_stats, sizeof(*stats));
+}
+
+void cc3xx_lowlevel_hash_reset_residency_stats(void)
+{
+    memset(&residency_stats, 0, sizeof(residency_stats));
+}
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
 void cc3xx_lowlevel_hash_finish(uint32_t *res, size_t length)
 {
 #ifdef CC3XX_CONFIG_STRICT_UINT32_T_ALIGNMENT
@@ -177,6 +328,13 @@ void cc3xx_lowlevel_hash_finish(uint32_t *res, size_t length)
     assert(((uintptr_t)res & 0b11) == 0);
 #endif
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    /* Whatever state is loaded is being consumed, so there is nothing to save
+     * back to its owner.
+     */
+    resident_state = NULL;
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
     /* Check size */
     switch (P_CC3XX->hash.hash_control & 0b1111) {
     case CC3XX_HASH_ALG_SHA256:
@@ -62,6 +62,29 @@
  */
 #define CC3XX_CONFIG_ENABLE_RANDOM_CTR_DRBG
 
+/*!
+ * Enables the Random module to instantiate the DRBG at boot from a seed
+ * persisted through the tfm_plat_crypto_nv_seed_read/write() platform
+ * functions, instead of waiting for the TRNG and its startup health test.
+ * The persisted seed is replaced with fresh DRBG output before any random
+ * number is returned, and the DRBG is reseeded with health tested TRNG
+ * entropy after \ref CC3XX_CONFIG_RANDOM_FAST_BOOT_RESEED_DELAY requests.
+ * When no seed is available, the DRBG is seeded from the TRNG as usual and
+ * a seed is persisted for the next boot.
+ * Until the reseed, the random output depends only on the persisted seed. If
+ * an attacker can roll back the storage holding it (e.g. an older ITS image),
+ * those first requests return the same random numbers as on a previous boot,
+ * so this must only be enabled where that storage is rollback protected
+ */
+#define CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+
+/*!
+ * Number of random requests, counting the one which instantiates the DRBG,
+ * served only from the persisted seed before the DRBG is reseeded from the
+ * TRNG. 0 reseeds on the first request. Defaults to 1
+ */
+#define CC3XX_CONFIG_RANDOM_FAST_BOOT_RESEED_DELAY (1)
+
 /*!
  * Enables the MAC module to perform the single-part API using a dedicated
  * function that directly calls into the low layer API, instead of resorting
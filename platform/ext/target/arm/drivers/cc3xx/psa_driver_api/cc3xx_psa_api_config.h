@@ -25,6 +25,12 @@
 //#define CC3XX_CONFIG_ENABLE_RANDOM_HMAC_DRBG
 #define CC3XX_CONFIG_ENABLE_RANDOM_CTR_DRBG
 
+/* Only with a rollback protected NV seed: until the TRNG reseed, the output
+ * is replayed if an older seed is restored. See cc3xx.h
+ */
+//#define CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+//#define CC3XX_CONFIG_RANDOM_FAST_BOOT_RESEED_DELAY (1)
+
 #define CC3XX_CONFIG_ENABLE_MAC_INTEGRATED_API
 
 #define CC3XX_CONFIG_ENABLE_STREAM_CIPHER
@@ -81,6 +81,11 @@ psa_status_t cc3xx_hash_clone(const cc3xx_hash_operation_t *source_operation,
     CC3XX_ASSERT(source_operation != NULL);
     CC3XX_ASSERT(target_operation != NULL);
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    /* If the source is resident in the engine, its context is stale */
+    cc3xx_lowlevel_hash_evict_resident_state();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
     memcpy(target_operation, source_operation, sizeof(cc3xx_hash_operation_t));
 
     return PSA_SUCCESS;
@@ -103,6 +108,19 @@ psa_status_t cc3xx_hash_update(cc3xx_hash_operation_t *operation,
     /* if len not zero, but pointer is NULL */
     CC3XX_ASSERT(input != NULL);
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    /* The state stays in the engine after the update, and is only saved back
+     * into the context if another operation needs the engine.
+     */
+    cc3xx_lowlevel_hash_acquire_state(&operation->ctx);
+
+    err = cc3xx_lowlevel_hash_update(input, input_length);
+
+    if (err != CC3XX_ERR_SUCCESS) {
+        cc3xx_lowlevel_hash_release_state(&operation->ctx);
+        return cc3xx_to_psa_err(err);
+    }
+#else
     cc3xx_lowlevel_hash_set_state(&operation->ctx);
 
     err = cc3xx_lowlevel_hash_update(input, input_length);
@@ -114,6 +132,7 @@ psa_status_t cc3xx_hash_update(cc3xx_hash_operation_t *operation,
     cc3xx_lowlevel_hash_get_state(&operation->ctx);
 
     cc3xx_lowlevel_hash_uninit();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
 
     return PSA_SUCCESS;
 }
@@ -125,7 +144,11 @@ psa_status_t cc3xx_hash_finish(cc3xx_hash_operation_t *operation,
     CC3XX_ASSERT(operation != NULL);
     CC3XX_ASSERT(hash_length != NULL);
 
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_acquire_state(&operation->ctx);
+#else
     cc3xx_lowlevel_hash_set_state(&operation->ctx);
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
 
     switch (operation->ctx.alg) {
     case CC3XX_HASH_ALG_SHA1:
@@ -139,6 +162,12 @@ psa_status_t cc3xx_hash_finish(cc3xx_hash_operation_t *operation,
         break;
     default:
         *hash_length = 0; /* This can't happen if the object has not been tampered with */
+        /* The engine must not be left holding this state */
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+        cc3xx_lowlevel_hash_release_state(&operation->ctx);
+#else
+        cc3xx_lowlevel_hash_uninit();
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
         return PSA_ERROR_CORRUPTION_DETECTED;
     }
 
@@ -149,6 +178,10 @@ psa_status_t cc3xx_hash_finish(cc3xx_hash_operation_t *operation,
 
 psa_status_t cc3xx_hash_abort(cc3xx_hash_operation_t *operation)
 {
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_lowlevel_hash_release_state(&operation->ctx);
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
     cc3xx_secure_erase_buffer((uint32_t *)operation, sizeof(cc3xx_hash_operation_t) / sizeof(uint32_t));
     return PSA_SUCCESS;
 }
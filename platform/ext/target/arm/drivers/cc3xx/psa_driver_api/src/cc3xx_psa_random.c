@@ -23,6 +23,10 @@
 #include "cc3xx_error.h"
 #include "cc3xx_drbg.h"
 #include "cc3xx_rng.h"
+#include "cc3xx_stdlib.h"
+#ifdef CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+#include "tfm_plat_crypto_nv_seed.h"
+#endif
 
 /* Include the definition of the context types */
 #include "cc3xx_crypto_primitives_private.h"
@@ -33,6 +37,17 @@
 #error "CC3XX configuration must have a single DRBG construction enabled"
 #endif
 
+#ifdef CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+/* Size of the persisted seed, kept the same as the seed file used by the
+ * mbed TLS entropy module so that the two can share the NV seed storage
+ */
+#define CC3XX_RANDOM_FAST_BOOT_SEED_SIZE (64)
+
+#ifndef CC3XX_CONFIG_RANDOM_FAST_BOOT_RESEED_DELAY
+#define CC3XX_CONFIG_RANDOM_FAST_BOOT_RESEED_DELAY (1)
+#endif
+#endif /* CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED */
+
 struct random_context_params_t {
     cc3xx_drbg_id_t type;
     size_t initial_entropy_size;
@@ -43,8 +58,96 @@ struct random_context_params_t {
 static struct {
     cc3xx_random_context_t ctx;
     bool isInitialized;
+#ifdef CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+    bool isReseedPending;    /* Seeded from NV, TRNG reseed still to do */
+    uint32_t reseedCountdown; /* Requests served before the TRNG reseed */
+#endif
 } cc3xx_psa_random_state;
 
+static const struct random_context_params_t g_random_conf = {
+#if defined(CC3XX_CONFIG_ENABLE_RANDOM_CTR_DRBG)
+    .type = CC3XX_DRBG_CTR, .initial_entropy_size = CC3XX_DRBG_CTR_SEEDLEN, .reseed_entropy_size = CC3XX_DRBG_CTR_SEEDLEN
+#elif defined(CC3XX_CONFIG_ENABLE_RANDOM_HMAC_DRBG)
+    .type = CC3XX_DRBG_HMAC, .initial_entropy_size = 32, .reseed_entropy_size = 32
+#elif defined(CC3XX_CONFIG_ENABLE_RANDOM_HASH_DRBG)
+    .type = CC3XX_DRBG_HASH, .initial_entropy_size = 32, .reseed_entropy_size = 32
+#endif
+};
+
+#ifdef CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+/* Replaces the persisted seed with fresh output of the DRBG, so that a seed
+ * is never used to instantiate the DRBG on more than one boot
+ */
+static psa_status_t random_refresh_nv_seed(cc3xx_random_context_t *context)
+{
+    uint32_t seed[CC3XX_RANDOM_FAST_BOOT_SEED_SIZE / sizeof(uint32_t)];
+    cc3xx_err_t err;
+    int nv_err;
+
+    err = cc3xx_lowlevel_drbg_generate(&(context->state), sizeof(seed) * 8,
+                                       (uint8_t *)seed, NULL, 0);
+    if (err != CC3XX_ERR_SUCCESS) {
+        return cc3xx_to_psa_err(err);
+    }
+
+    nv_err = tfm_plat_crypto_nv_seed_write((const unsigned char *)seed, sizeof(seed));
+    cc3xx_secure_erase_buffer(seed, sizeof(seed) / sizeof(uint32_t));
+
+    return (nv_err == TFM_CRYPTO_NV_SEED_SUCCESS) ? PSA_SUCCESS : PSA_ERROR_STORAGE_FAILURE;
+}
+
+/* Instantiates the DRBG from the persisted seed, which avoids waiting for the
+ * TRNG and its startup health test at boot. Fresh TRNG entropy is mixed in
+ * by a reseed once the first requests have been served
+ */
+static psa_status_t random_init_from_nv_seed(cc3xx_random_context_t *context)
+{
+    uint32_t seed[CC3XX_RANDOM_FAST_BOOT_SEED_SIZE / sizeof(uint32_t)];
+    cc3xx_err_t err;
+    psa_status_t status;
+
+    if (tfm_plat_crypto_nv_seed_read((unsigned char *)seed, sizeof(seed))
+        != TFM_CRYPTO_NV_SEED_SUCCESS) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    err = cc3xx_lowlevel_drbg_init(g_random_conf.type, &(context->state),
+                                   (const uint8_t *)seed, g_random_conf.initial_entropy_size,
+                                   NULL, 0, NULL, 0);
+    cc3xx_secure_erase_buffer(seed, sizeof(seed) / sizeof(uint32_t));
+    if (err != CC3XX_ERR_SUCCESS) {
+        return cc3xx_to_psa_err(err);
+    }
+
+    /* If the seed can't be replaced, the next boot would produce the same
+     * output again, so the DRBG must not be used in this state
+     */
+    status = random_refresh_nv_seed(context);
+    if (status != PSA_SUCCESS) {
+        (void)cc3xx_lowlevel_drbg_uninit(&(context->state));
+    }
+
+    return status;
+}
+
+static psa_status_t random_reseed_from_trng(cc3xx_random_context_t *context)
+{
+    uint32_t entropy[g_random_conf.reseed_entropy_size / sizeof(uint32_t)];
+    cc3xx_err_t err;
+
+    err = cc3xx_get_entropy(0, NULL, (uint8_t *)entropy, sizeof(entropy));
+    if (err == CC3XX_ERR_SUCCESS) {
+        err = cc3xx_lowlevel_drbg_reseed(&(context->state), (const uint8_t *)entropy,
+                                         sizeof(entropy), NULL, 0);
+    }
+
+    /* A failed collection may still have written part of the buffer */
+    cc3xx_secure_erase_buffer(entropy, sizeof(entropy) / sizeof(uint32_t));
+
+    return cc3xx_to_psa_err(err);
+}
+#endif /* CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED */
+
 /** @defgroup psa_random PSA driver entry points for collecting random
  *                       numbers generated using an underlying DRBG
  *                       mechanism
@@ -57,16 +160,7 @@ static struct {
 psa_status_t cc3xx_init_random(cc3xx_random_context_t *context)
 {
     cc3xx_err_t err;
-    const struct random_context_params_t conf = {
-#if defined(CC3XX_CONFIG_ENABLE_RANDOM_CTR_DRBG)
-    .type = CC3XX_DRBG_CTR, .initial_entropy_size = CC3XX_DRBG_CTR_SEEDLEN, .reseed_entropy_size = CC3XX_DRBG_CTR_SEEDLEN
-#elif defined(CC3XX_CONFIG_ENABLE_RANDOM_HMAC_DRBG)
-    .type = CC3XX_DRBG_HMAC, .initial_entropy_size = 32, .reseed_entropy_size = 32
-#elif defined(CC3XX_CONFIG_ENABLE_RANDOM_HASH_DRBG)
-    .type = CC3XX_DRBG_HASH, .initial_entropy_size = 32, .reseed_entropy_size = 32
-#endif
-    };
-    uint8_t initial_entropy[conf.initial_entropy_size];
+    uint8_t initial_entropy[g_random_conf.initial_entropy_size];
 
     CC3XX_ASSERT(context != NULL);
 
@@ -75,7 +169,7 @@ psa_status_t cc3xx_init_random(cc3xx_random_context_t *context)
         return cc3xx_to_psa_err(err);
     }
 
-    err = cc3xx_lowlevel_drbg_init(conf.type, &(context->state),
+    err = cc3xx_lowlevel_drbg_init(g_random_conf.type, &(context->state),
                                    initial_entropy, sizeof(initial_entropy),
                                    NULL, 0, NULL, 0);
     if (err != CC3XX_ERR_SUCCESS) {
@@ -135,13 +229,45 @@ psa_status_t cc3xx_internal_get_random(uint8_t *output, size_t output_size, size
     CC3XX_ASSERT(output_length != NULL);
 
     if (!cc3xx_psa_random_state.isInitialized) {
+#ifdef CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+        status = random_init_from_nv_seed(&cc3xx_psa_random_state.ctx);
+        if (status == PSA_SUCCESS) {
+            cc3xx_psa_random_state.isReseedPending = true;
+            cc3xx_psa_random_state.reseedCountdown = CC3XX_CONFIG_RANDOM_FAST_BOOT_RESEED_DELAY;
+        } else {
+            /* No usable seed, e.g. on first boot: seed from the TRNG, then
+             * persist a seed for the following boots
+             */
+            status = cc3xx_init_random(&cc3xx_psa_random_state.ctx);
+            if (status == PSA_SUCCESS) {
+                (void)random_refresh_nv_seed(&cc3xx_psa_random_state.ctx);
+            }
+        }
+#else
         status = cc3xx_init_random(&cc3xx_psa_random_state.ctx);
+#endif /* CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED */
         if (status == PSA_SUCCESS) {
             cc3xx_psa_random_state.isInitialized = true;
         } else {
             return status;
         }
     }
+#ifdef CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED
+    /* The request which instantiated the DRBG from the persisted seed counts
+     * as the first of the delayed requests
+     */
+    if (cc3xx_psa_random_state.isReseedPending) {
+        if (cc3xx_psa_random_state.reseedCountdown > 0) {
+            cc3xx_psa_random_state.reseedCountdown--;
+        } else {
+            status = random_reseed_from_trng(&cc3xx_psa_random_state.ctx);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+            cc3xx_psa_random_state.isReseedPending = false;
+        }
+    }
+#endif /* CC3XX_CONFIG_ENABLE_RANDOM_FAST_BOOT_SEED */
 
     return cc3xx_get_random(&cc3xx_psa_random_state.ctx,
                             output, output_size, output_length);
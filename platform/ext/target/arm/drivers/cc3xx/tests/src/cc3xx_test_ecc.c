@@ -328,6 +328,82 @@ cleanup:
     return rc;
 }
 
+#ifdef CC3XX_EC_GENERATOR_COMB_ENABLE
+/* Multiplies the curve generator by a scalar both through the fixed-base comb
+ * (used when the point passed in is the curve generator itself) and through the
+ * generic ladder on a copy of the generator, checking that the results match
+ * and logging the cycle counts of both.
+ */
+int cc3xx_test_ecc_exp_generator(cc3xx_ec_point_exp_test_data_t *data)
+{
+    cc3xx_ec_point_affine generator_copy;
+    cc3xx_pka_reg_id_t s;
+    cc3xx_ec_point_affine comb_result;
+    cc3xx_ec_point_affine ladder_result;
+    cc3xx_ec_curve_t curve;
+    const cc3xx_ec_curve_data_t *curve_data;
+    uint32_t comb_x[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t comb_y[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t ladder_x[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t ladder_y[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    size_t point_size;
+    uint32_t comb_cycles;
+    uint32_t ladder_cycles;
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    int rc;
+
+    err = cc3xx_lowlevel_ec_init(data->curve_id, &curve);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    curve_data = cc3xx_lowlevel_ec_get_curve_data(data->curve_id);
+    point_size = curve_data->modulus_size;
+
+    if (curve_data->generator_comb_table == NULL) {
+        /* Comb not enabled for this curve, nothing to compare against */
+        rc = 0;
+        goto cleanup;
+    }
+
+    generator_copy = cc3xx_lowlevel_ec_allocate_point();
+    cc3xx_lowlevel_pka_copy(curve.generator.x, generator_copy.x);
+    cc3xx_lowlevel_pka_copy(curve.generator.y, generator_copy.y);
+
+    s = cc3xx_lowlevel_pka_allocate_reg();
+    cc3xx_lowlevel_pka_write_reg_swap_endian(s, (uint32_t *)data->s, sizeof(data->s));
+
+    comb_result = cc3xx_lowlevel_ec_allocate_point();
+    ladder_result = cc3xx_lowlevel_ec_allocate_point();
+
+    cyccnt_start = get_cycle_count();
+    err = cc3xx_lowlevel_ec_multiply_point_by_scalar(&curve, &curve.generator, s,
+                                                     &comb_result);
+    comb_cycles = get_cycle_count() - cyccnt_start;
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    cyccnt_start = get_cycle_count();
+    err = cc3xx_lowlevel_ec_multiply_point_by_scalar(&curve, &generator_copy, s,
+                                                     &ladder_result);
+    ladder_cycles = get_cycle_count() - cyccnt_start;
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    cc3xx_lowlevel_pka_read_reg_swap_endian(comb_result.x, comb_x, point_size);
+    cc3xx_lowlevel_pka_read_reg_swap_endian(comb_result.y, comb_y, point_size);
+    cc3xx_lowlevel_pka_read_reg_swap_endian(ladder_result.x, ladder_x, point_size);
+    cc3xx_lowlevel_pka_read_reg_swap_endian(ladder_result.y, ladder_y, point_size);
+
+    cc3xx_test_assert(memcmp(comb_x, ladder_x, point_size) == 0);
+    cc3xx_test_assert(memcmp(comb_y, ladder_y, point_size) == 0);
+
+    TEST_LOG("generator multiplication: %d cycles comb, %d cycles ladder\r\n",
+             comb_cycles, ladder_cycles);
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+#endif /* CC3XX_EC_GENERATOR_COMB_ENABLE */
+
 static void ecc_tests_run(struct test_result_t *ret)
 {
     for (int idx = 0;
@@ -341,6 +417,11 @@ static void ecc_tests_run(struct test_result_t *ret)
     TEST_ASSERT(cc3xx_test_ecc_add_points(&add_test_data) == 0, "Point addition should succeed");
     TEST_ASSERT(cc3xx_test_ecc_exp_point(&exp_test_data_small) == 0, "point exponentiation should succeed (small example)");
     TEST_ASSERT(cc3xx_test_ecc_exp_point(&exp_test_data) == 0, "point exponentiation should succeed");
+#ifdef CC3XX_EC_GENERATOR_COMB_ENABLE
+    enable_cycle_counter();
+    TEST_ASSERT(cc3xx_test_ecc_exp_generator(&exp_test_data) == 0,
+                "generator comb multiplication should match the generic path");
+#endif /* CC3XX_EC_GENERATOR_COMB_ENABLE */
 
     ret->val = TEST_PASSED;
     return;
@@ -3414,6 +3414,188 @@ static int curve_id_to_name(cc3xx_ec_curve_id_t curve_id, const char **curve_nam
     return 0;
 }
 
+#define ECDSA_TEST_BATCH_MAX_ENTRIES 8
+
+static int hash_test_data(cc3xx_ecdsa_validate_test_data_t *data,
+                          uint32_t *hash, size_t *hash_len)
+{
+    cc3xx_err_t err;
+
+    switch(data->hash_alg) {
+    case CC3XX_HASH_ALG_SHA1:
+        *hash_len = SHA1_OUTPUT_SIZE;
+        break;
+    case CC3XX_HASH_ALG_SHA224:
+        *hash_len = SHA224_OUTPUT_SIZE;
+        break;
+    case CC3XX_HASH_ALG_SHA256:
+        *hash_len = SHA256_OUTPUT_SIZE;
+        break;
+    default:
+        return 1;
+    };
+
+    err = cc3xx_lowlevel_hash_init(data->hash_alg);
+    if (err != CC3XX_ERR_SUCCESS) {
+        return 1;
+    }
+
+    err = cc3xx_lowlevel_hash_update(data->Msg, data->Msg_len);
+    if (err != CC3XX_ERR_SUCCESS) {
+        cc3xx_lowlevel_hash_uninit();
+        return 1;
+    }
+
+    cc3xx_lowlevel_hash_finish(hash, *hash_len);
+
+    return 0;
+}
+
+static void batch_entry_from_test_data(cc3xx_ecdsa_validate_test_data_t *data,
+                                       const uint32_t *hash, size_t hash_len,
+                                       struct cc3xx_ecdsa_verify_batch_entry_t *entry)
+{
+    entry->public_key_x = (const uint32_t *)data->Qx;
+    entry->public_key_x_len = data->Qx_len;
+    entry->public_key_y = (const uint32_t *)data->Qy;
+    entry->public_key_y_len = data->Qy_len;
+    entry->hash = hash;
+    entry->hash_len = hash_len;
+    entry->sig_r = (const uint32_t *)data->R;
+    entry->sig_r_len = data->R_len;
+    entry->sig_s = (const uint32_t *)data->S;
+    entry->sig_s_len = data->S_len;
+}
+
+/* Verifies runs of test vectors on the same curve both one at a time and as a
+ * batch, checking that the results match and logging the cycle counts of both.
+ */
+int cc3xx_test_ecdsa_verify_batch(cc3xx_ecdsa_validate_test_data_t *data,
+                                  size_t data_amount)
+{
+    static uint32_t hashes[ECDSA_TEST_BATCH_MAX_ENTRIES][8];
+    struct cc3xx_ecdsa_verify_batch_entry_t entries[ECDSA_TEST_BATCH_MAX_ENTRIES];
+    cc3xx_ecdsa_validate_test_data_t *entry_data[ECDSA_TEST_BATCH_MAX_ENTRIES];
+    cc3xx_err_t single_results[ECDSA_TEST_BATCH_MAX_ENTRIES];
+    cc3xx_err_t batch_results[ECDSA_TEST_BATCH_MAX_ENTRIES];
+    const char *curve_name = NULL;
+    bool all_expected_valid;
+    uint32_t single_cycles;
+    uint32_t batch_cycles;
+    uint32_t cyccnt_start;
+    size_t hash_len;
+    size_t entry_amount;
+    size_t data_idx = 0;
+    size_t idx;
+    cc3xx_err_t err;
+    int rc;
+
+    while (data_idx < data_amount) {
+        cc3xx_ec_curve_id_t curve_id = data[data_idx].curve_id;
+
+        entry_amount = 0;
+        all_expected_valid = true;
+        for (; data_idx < data_amount
+               && data[data_idx].curve_id == curve_id
+               && entry_amount < ECDSA_TEST_BATCH_MAX_ENTRIES; data_idx++) {
+            /* Skip vectors using a hash which isn't enabled */
+            if (hash_test_data(&data[data_idx], hashes[entry_amount], &hash_len)) {
+                continue;
+            }
+
+            batch_entry_from_test_data(&data[data_idx], hashes[entry_amount],
+                                       hash_len, &entries[entry_amount]);
+            entry_data[entry_amount] = &data[data_idx];
+            all_expected_valid &= data[data_idx].expected;
+            entry_amount++;
+        }
+
+        if (entry_amount == 0) {
+            continue;
+        }
+
+        cyccnt_start = get_cycle_count();
+        for (idx = 0; idx < entry_amount; idx++) {
+            single_results[idx] = cc3xx_lowlevel_ecdsa_verify(curve_id,
+                                    entries[idx].public_key_x, entries[idx].public_key_x_len,
+                                    entries[idx].public_key_y, entries[idx].public_key_y_len,
+                                    entries[idx].hash, entries[idx].hash_len,
+                                    entries[idx].sig_r, entries[idx].sig_r_len,
+                                    entries[idx].sig_s, entries[idx].sig_s_len);
+        }
+        single_cycles = get_cycle_count() - cyccnt_start;
+
+        if (single_results[0] == CC3XX_ERR_EC_CURVE_NOT_SUPPORTED) {
+            continue;
+        }
+
+        cyccnt_start = get_cycle_count();
+        err = cc3xx_lowlevel_ecdsa_verify_batch(curve_id, entries, entry_amount,
+                                                batch_results);
+        batch_cycles = get_cycle_count() - cyccnt_start;
+
+        for (idx = 0; idx < entry_amount; idx++) {
+            cc3xx_test_assert(batch_results[idx] == single_results[idx]);
+            cc3xx_test_assert((batch_results[idx] == CC3XX_ERR_SUCCESS)
+                              == entry_data[idx]->expected);
+        }
+        cc3xx_test_assert((err == CC3XX_ERR_SUCCESS) == all_expected_valid);
+
+        /* Without a results buffer, only the overall result is reported */
+        err = cc3xx_lowlevel_ecdsa_verify_batch(curve_id, entries, entry_amount,
+                                                NULL);
+        cc3xx_test_assert((err == CC3XX_ERR_SUCCESS) == all_expected_valid);
+
+        if (curve_id_to_name(curve_id, &curve_name)) {
+            curve_name = "unknown curve";
+        }
+        TEST_LOG("%s verify of %u signatures: %u cycles one by one, %u cycles batched\r\n",
+                 curve_name, (uint32_t)entry_amount, single_cycles, batch_cycles);
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+
+/* Verifies the same signature several times in one batch, so that the public
+ * key is only loaded once.
+ */
+int cc3xx_test_ecdsa_verify_batch_same_key(cc3xx_ecdsa_validate_test_data_t *data)
+{
+    struct cc3xx_ecdsa_verify_batch_entry_t entries[4];
+    cc3xx_err_t results[4];
+    uint32_t hash[8];
+    size_t hash_len;
+    size_t idx;
+    cc3xx_err_t err;
+    int rc;
+
+    if (hash_test_data(data, hash, &hash_len)) {
+        rc = 0;
+        goto cleanup;
+    }
+
+    for (idx = 0; idx < 4; idx++) {
+        batch_entry_from_test_data(data, hash, hash_len, &entries[idx]);
+    }
+
+    err = cc3xx_lowlevel_ecdsa_verify_batch(data->curve_id, entries, 4, results);
+    if (err == CC3XX_ERR_EC_CURVE_NOT_SUPPORTED) {
+        rc = 0;
+        goto cleanup;
+    }
+    cc3xx_test_assert((err == CC3XX_ERR_SUCCESS) == data->expected);
+
+    for (idx = 0; idx < 4; idx++) {
+        cc3xx_test_assert((results[idx] == CC3XX_ERR_SUCCESS) == data->expected);
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+
 int cc3xx_test_sign_verify(cc3xx_ecdsa_validate_test_data_t *data)
 {
     cc3xx_err_t err;
@@ -3755,6 +3937,14 @@ static void ecdsa_tests_run(struct test_result_t *ret)
                 "TEST_ECDSA_GETPUB failed");
 #endif /* CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE */
 
+#if defined(CC3XX_CONFIG_ECDSA_VERIFY_ENABLE)
+    TEST_ASSERT(cc3xx_test_ecdsa_verify_batch(cavp_validate_test_data,
+                    sizeof(cavp_validate_test_data) / sizeof(cavp_validate_test_data[0])) == 0,
+                "TEST_ECDSA_VERIFY_BATCH failed");
+    TEST_ASSERT(cc3xx_test_ecdsa_verify_batch_same_key(&cavp_validate_test_data[0]) == 0,
+                "TEST_ECDSA_VERIFY_BATCH_SAME_KEY failed");
+#endif /* CC3XX_CONFIG_ECDSA_VERIFY_ENABLE */
+
     ret->val = TEST_PASSED;
     return;
 }
@@ -116,6 +116,58 @@ size_t hash_size_from_alg(cc3xx_hash_alg_t alg)
     }
 }
 
+static int hash_test_lazy_state_save(struct hash_test_data_t *data,
+                                     cc3xx_hash_alg_t alg)
+{
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    if (hash_test_lowlevel_interleaved(data, alg, 4, 31, true, NULL) != 0) {
+        return 1;
+    }
+
+    return hash_test_lowlevel_lazy_state_counters(data, alg, 32);
+#else
+    return 0;
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+}
+
+static void hash_test_interleaved_cycle_counts(struct test_result_t *ret)
+{
+    const size_t stream_amounts[] = {2, 4, 8};
+    uint32_t eager_cycles;
+    uint32_t lazy_cycles;
+    size_t idx;
+
+    for (idx = 0; idx < ARRAY_SIZE(stream_amounts); idx++) {
+        TEST_ASSERT(hash_test_lowlevel_interleaved(&hash_test_long,
+                                                   CC3XX_HASH_ALG_SHA256,
+                                                   stream_amounts[idx], 16,
+                                                   false, &eager_cycles) == 0,
+                    "Eagerly saved interleaved hash streams should pass");
+        TEST_LOG("%u streams, state saved every update: %u cycles\r\n",
+                 (uint32_t)stream_amounts[idx], eager_cycles);
+
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+        TEST_ASSERT(hash_test_lowlevel_interleaved(&hash_test_long,
+                                                   CC3XX_HASH_ALG_SHA256,
+                                                   stream_amounts[idx], 16,
+                                                   true, &lazy_cycles) == 0,
+                    "Lazily saved interleaved hash streams should pass");
+        TEST_LOG("%u streams, state saved on preemption: %u cycles\r\n",
+                 (uint32_t)stream_amounts[idx], lazy_cycles);
+#else
+        (void)lazy_cycles;
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+static struct test_t hash_interleaved_cycle_count_tests = {
+    &hash_test_interleaved_cycle_counts,
+    "CC3XX_HASH_TEST_INTERLEAVED_CYCLE_COUNTS",
+    "CC3XX interleaved hash streams cycle counts benchmark",
+};
+
 #define CREATE_HASH_TESTSUITE(alg) \
 static void hash_ ## alg  ## _lowlevel_tests_run(struct test_result_t *ret) \
 { \
@@ -139,6 +191,19 @@ static void hash_ ## alg  ## _lowlevel_tests_run(struct test_result_t *ret) \
                 "multipart hash_test_long should pass with chunk size 64"); \
     TEST_ASSERT(hash_test_lowlevel_saveload_multipart(&hash_test_long, alg, 64) == 0, \
                 "multipart saveload hash_test_long should pass with chunk size 64"); \
+    TEST_ASSERT(hash_test_lowlevel_update_and_copy(&hash_test_long, alg, 128) == 0, \
+                "update_and_copy hash_test_long should pass with chunk size 128"); \
+    TEST_ASSERT(hash_test_lowlevel_update_and_copy(&hash_test_long, alg, 31) == 0, \
+                "update_and_copy hash_test_long should pass with chunk size 31"); \
+    TEST_ASSERT(hash_test_lowlevel_update_and_copy(&hash_test_short, alg, 7) == 0, \
+                "update_and_copy hash_test_short should pass"); \
+    TEST_ASSERT(hash_test_lowlevel_update_and_copy(&hash_test_zero, alg, 1) == 0, \
+                "update_and_copy hash_test_zero should pass"); \
+    TEST_ASSERT(hash_test_lowlevel_interleaved(&hash_test_long, alg, 4, 31, \
+                                               false, NULL) == 0, \
+                "interleaved hash_test_long should pass with 4 streams"); \
+    TEST_ASSERT(hash_test_lazy_state_save(&hash_test_long, alg) == 0, \
+                "lazy state save of hash_test_long should pass"); \
     TEST_ASSERT(hash_test_lowlevel_reinit(&hash_test_block, alg) == 0, \
                 "reiniting hash_test_block should pass"); \
     ret->val = TEST_PASSED; \
@@ -158,6 +223,9 @@ void add_cc3xx_hash_tests_to_testsuite(struct test_suite_t *p_ts, uint32_t ts_si
 {
 #ifdef CC3XX_CONFIG_HASH_SHA256_ENABLE
     cc3xx_add_tests_to_testsuite(&hash_CC3XX_HASH_ALG_SHA256_tests, 1, p_ts, ts_size);
+
+    enable_cycle_counter();
+    cc3xx_add_tests_to_testsuite(&hash_interleaved_cycle_count_tests, 1, p_ts, ts_size);
 #endif /* CC3XX_CONFIG_HASH_SHA256_ENABLE */
 
 #ifdef CC3XX_CONFIG_HASH_SHA224_ENABLE
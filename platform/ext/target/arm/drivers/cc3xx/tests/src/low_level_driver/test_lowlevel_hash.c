@@ -9,6 +9,7 @@
 
 #include "cc3xx_hash.h"
 #include "cc3xx_test_assert.h"
+#include "cc3xx_test_utils.h"
 
 #include <string.h>
 
@@ -69,6 +70,42 @@ cleanup:
     return rc;
 }
 
+int hash_test_lowlevel_update_and_copy(struct hash_test_data_t *data,
+                                       cc3xx_hash_alg_t alg,
+                                       size_t chunk_size)
+{
+    uint32_t output[SHA256_OUTPUT_SIZE / sizeof(uint32_t)] = {0};
+    uint8_t copy[256] = {0};
+    cc3xx_err_t err;
+    size_t idx;
+    int rc;
+
+    cc3xx_test_assert(data->input_size <= sizeof(copy));
+
+    err = cc3xx_lowlevel_hash_init(alg);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    for (idx = 0; idx < data->input_size; idx += chunk_size) {
+        err = cc3xx_lowlevel_hash_update_and_copy(data->input + idx,
+                                       data->input_size - idx < chunk_size ?
+                                       data->input_size - idx : chunk_size,
+                                       copy + idx);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+    }
+
+    cc3xx_lowlevel_hash_finish(output, hash_size_from_alg(alg));
+
+    cc3xx_test_assert(memcmp(output, output_from_alg_and_data(alg, data),
+                             hash_size_from_alg(alg)) == 0);
+    cc3xx_test_assert(memcmp(copy, data->input, data->input_size) == 0);
+
+    rc = 0;
+cleanup:
+    cc3xx_lowlevel_hash_uninit();
+
+    return rc;
+}
+
 int hash_test_lowlevel_reinit(struct hash_test_data_t *data,
                               cc3xx_hash_alg_t alg)
 {
@@ -130,3 +167,126 @@ cleanup:
 
     return rc;
 }
+
+int hash_test_lowlevel_interleaved(struct hash_test_data_t *data,
+                                   cc3xx_hash_alg_t alg,
+                                   size_t stream_amount,
+                                   size_t chunk_size,
+                                   bool lazy,
+                                   uint32_t *cycles)
+{
+    static struct cc3xx_hash_state_t states[8];
+    uint32_t output[SHA256_OUTPUT_SIZE / sizeof(uint32_t)] = {0};
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    size_t idx;
+    size_t stream_idx;
+    size_t update_size;
+    int rc;
+
+    cc3xx_test_assert(stream_amount <= sizeof(states) / sizeof(states[0]));
+#ifndef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    cc3xx_test_assert(!lazy);
+#endif /* !CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
+    for (stream_idx = 0; stream_idx < stream_amount; stream_idx++) {
+        err = cc3xx_lowlevel_hash_init(alg);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        cc3xx_lowlevel_hash_get_state(&states[stream_idx]);
+        cc3xx_lowlevel_hash_uninit();
+    }
+
+    cyccnt_start = get_cycle_count();
+
+    /* Each stream hashes the same data, one chunk at a time in turn */
+    for (idx = 0; idx < data->input_size; idx += chunk_size) {
+        update_size = data->input_size - idx < chunk_size ?
+                      data->input_size - idx : chunk_size;
+
+        for (stream_idx = 0; stream_idx < stream_amount; stream_idx++) {
+            if (lazy) {
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+                cc3xx_lowlevel_hash_acquire_state(&states[stream_idx]);
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+            } else {
+                cc3xx_lowlevel_hash_set_state(&states[stream_idx]);
+            }
+
+            err = cc3xx_lowlevel_hash_update(data->input + idx, update_size);
+            cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+            if (!lazy) {
+                cc3xx_lowlevel_hash_get_state(&states[stream_idx]);
+                cc3xx_lowlevel_hash_uninit();
+            }
+        }
+    }
+
+    if (cycles != NULL) {
+        *cycles = get_cycle_count() - cyccnt_start;
+    }
+
+    for (stream_idx = 0; stream_idx < stream_amount; stream_idx++) {
+        if (lazy) {
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+            cc3xx_lowlevel_hash_acquire_state(&states[stream_idx]);
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+        } else {
+            cc3xx_lowlevel_hash_set_state(&states[stream_idx]);
+        }
+
+        cc3xx_lowlevel_hash_finish(output, hash_size_from_alg(alg));
+
+        cc3xx_test_assert(memcmp(output, output_from_alg_and_data(alg, data),
+                                 hash_size_from_alg(alg)) == 0);
+    }
+
+    rc = 0;
+cleanup:
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+    for (stream_idx = 0; stream_idx < stream_amount; stream_idx++) {
+        cc3xx_lowlevel_hash_release_state(&states[stream_idx]);
+    }
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+    cc3xx_lowlevel_hash_uninit();
+
+    return rc;
+}
+
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+int hash_test_lowlevel_lazy_state_counters(struct hash_test_data_t *data,
+                                           cc3xx_hash_alg_t alg,
+                                           size_t chunk_size)
+{
+    struct cc3xx_hash_residency_stats_t stats;
+    size_t chunk_amount = (data->input_size + chunk_size - 1) / chunk_size;
+    int rc;
+
+    cc3xx_lowlevel_hash_reset_residency_stats();
+
+    /* A single stream is only loaded once, and never saved */
+    rc = hash_test_lowlevel_interleaved(data, alg, 1, chunk_size, true, NULL);
+    cc3xx_test_assert(rc == 0);
+
+    cc3xx_lowlevel_hash_get_residency_stats(&stats);
+    cc3xx_test_assert(stats.restores == 1);
+    cc3xx_test_assert(stats.hits == chunk_amount);
+    cc3xx_test_assert(stats.saves == 0);
+
+    cc3xx_lowlevel_hash_reset_residency_stats();
+
+    /* Two streams in turn preempt each other on every update */
+    rc = hash_test_lowlevel_interleaved(data, alg, 2, chunk_size, true, NULL);
+    cc3xx_test_assert(rc == 0);
+
+    cc3xx_lowlevel_hash_get_residency_stats(&stats);
+    cc3xx_test_assert(stats.restores == 2 * chunk_amount + 2);
+    cc3xx_test_assert(stats.hits == 0);
+    cc3xx_test_assert(stats.saves == 2 * chunk_amount);
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
@@ -10,6 +10,8 @@
 
 #include "cc3xx_test_hash.h"
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -19,6 +21,9 @@ int hash_test_lowlevel_oneshot(struct hash_test_data_t *data,
 int hash_test_lowlevel_multipart(struct hash_test_data_t *data,
                                  cc3xx_hash_alg_t alg,
                                  size_t chunk_size);
+int hash_test_lowlevel_update_and_copy(struct hash_test_data_t *data,
+                                       cc3xx_hash_alg_t alg,
+                                       size_t chunk_size);
 int hash_test_lowlevel_reinit(struct hash_test_data_t *data,
                               cc3xx_hash_alg_t alg);
 
@@ -26,6 +31,19 @@ int hash_test_lowlevel_saveload_multipart(struct hash_test_data_t *data,
                                           cc3xx_hash_alg_t alg,
                                           size_t chunk_size);
 
+int hash_test_lowlevel_interleaved(struct hash_test_data_t *data,
+                                   cc3xx_hash_alg_t alg,
+                                   size_t stream_amount,
+                                   size_t chunk_size,
+                                   bool lazy,
+                                   uint32_t *cycles);
+
+#ifdef CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE
+int hash_test_lowlevel_lazy_state_counters(struct hash_test_data_t *data,
+                                           cc3xx_hash_alg_t alg,
+                                           size_t chunk_size);
+#endif /* CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
 #ifdef __cplusplus
 }
 #endif
@@ -364,6 +364,26 @@ fih_int bl1_hash_update(const uint8_t *data,
     FIH_RET(fih_rc);
 }
 
+fih_int bl1_hash_update_and_copy(const uint8_t *data,
+                                 size_t data_length,
+                                 uint8_t *out)
+{
+    fih_int fih_rc;
+
+    switch(multipart_alg) {
+    case TFM_BL1_HASH_ALG_SHA256:
+        fih_rc = fih_int_encode_zero_equality(
+                     cc3xx_lowlevel_hash_update_and_copy(data, data_length, out));
+        break;
+    default:
+        /* Only SHA-256 is computed by the CC, hash the copy otherwise */
+        memcpy(out, data, data_length);
+        FIH_CALL(bl1_hash_update, fih_rc, out, data_length);
+    }
+
+    FIH_RET(fih_rc);
+}
+
 fih_int bl1_hash_finish(uint8_t *hash,
                         size_t hash_length,
                         size_t *hash_size)
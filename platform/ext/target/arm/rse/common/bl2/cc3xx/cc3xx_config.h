@@ -25,6 +25,19 @@
 /* Whether the SHA1 hash support is enabled */
 /* #define CC3XX_CONFIG_HASH_SHA1_ENABLE */
 
+/* Whether the hash engine can forward its input to the DMA output in the same
+ * pass (the hash-and-bypass flow), which allows copy-and-hash operations to
+ * read their input only once.
+ */
+/* #define CC3XX_CONFIG_HASH_AND_BYPASS_ENABLE */
+
+/* Whether a multipart hash operation's state is left loaded in the hash engine
+ * between updates, and only saved back when another operation needs the
+ * engine. This requires that the driver is only used from a single context,
+ * and that every operation is aborted or finished before its memory is reused.
+ */
+/* #define CC3XX_CONFIG_HASH_LAZY_STATE_SAVE_ENABLE */
+
 /* Whether the AES CTR support is enabled */
 #define CC3XX_CONFIG_AES_CTR_ENABLE
 
@@ -191,6 +204,13 @@
  */
 #define CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE
 
+/* Whether multiplications of the generator of the curve use a fixed-base comb
+ * with a precomputed table instead of the generic point-scalar multiplication.
+ * Has a ROM cost of 1KiB for P-256 and 1.5KiB for P-384.
+ */
+/* #define CC3XX_CONFIG_EC_CURVE_SECP_256_R1_GENERATOR_COMB_ENABLE */
+/* #define CC3XX_CONFIG_EC_CURVE_SECP_384_R1_GENERATOR_COMB_ENABLE */
+
 /* Whether various ECDSA features are enabled */
 /* #define CC3XX_CONFIG_ECDSA_SIGN_ENABLE */
 #define CC3XX_CONFIG_ECDSA_VERIFY_ENABLE
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -10,26 +10,63 @@
 #include "dma350_privileged_config.h"
 #include "dma350_lib.h"
 #include "device_definition.h"
+#include "tfm_hal_dma_copy.h"
 #include "utilities.h"
 
 #ifndef RSE_DMA_MIN_SIZE
 #define RSE_DMA_MIN_SIZE 1024
 #endif /* RSE_DMA_MIN_SIZE */
 
-void *spm_dma_memcpy(void *dest, const void *src, size_t n)
+size_t tfm_hal_dma_copy_min_size(void)
+{
+    return RSE_DMA_MIN_SIZE;
+}
+
+enum tfm_hal_status_t tfm_hal_dma_copy_start(void *dest, const void *src, size_t n)
 {
     enum dma350_lib_error_t err;
 
+    if (dma350_ch_is_busy(&DMA350_DMA0_CH0_DEV_S)) {
+        return TFM_HAL_ERROR_BAD_STATE;
+    }
+
+    err = dma350_memcpy(&DMA350_DMA0_CH0_DEV_S, src, dest, n,
+                        DMA350_LIB_EXEC_START_ONLY);
+    if (err != DMA350_LIB_ERR_NONE) {
+        return TFM_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    return TFM_HAL_SUCCESS;
+}
+
+bool tfm_hal_dma_copy_is_done(void)
+{
+    return !dma350_ch_is_busy(&DMA350_DMA0_CH0_DEV_S);
+}
+
+enum tfm_hal_status_t tfm_hal_dma_copy_wait(void)
+{
+    union dma350_ch_status_t status;
+
+    status = dma350_ch_wait_status(&DMA350_DMA0_CH0_DEV_S);
+    if (!status.b.STAT_DONE || status.b.STAT_ERR) {
+        return TFM_HAL_ERROR_GENERIC;
+    }
+
+    return TFM_HAL_SUCCESS;
+}
+
+void *spm_dma_memcpy(void *dest, const void *src, size_t n)
+{
     if (n < RSE_DMA_MIN_SIZE) {
         return memcpy(dest, src, n);
-    } else {
-        err = dma350_memcpy(&DMA350_DMA0_CH0_DEV_S, (void *)src, dest, n,
-                            DMA350_LIB_EXEC_BLOCKING);
-        if (err != DMA350_LIB_ERR_NONE) {
-            /* Memcpy can't return an error, so this the only option */
-            tfm_core_panic();
-        }
-
-        return dest;
     }
+
+    if ((tfm_hal_dma_copy_start(dest, src, n) != TFM_HAL_SUCCESS) ||
+        (tfm_hal_dma_copy_wait() != TFM_HAL_SUCCESS)) {
+        /* Memcpy can't return an error, so this the only option */
+        tfm_core_panic();
+    }
+
+    return dest;
 }
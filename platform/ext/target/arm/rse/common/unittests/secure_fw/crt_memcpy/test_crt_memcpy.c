@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity.h"
+
+/* Covers two iterations of every block loop, plus every tail length */
+#define TEST_MAX_LENGTH     (2 * 8 * sizeof(uint32_t) + 2 * sizeof(uint32_t) + 3)
+/* Room for the largest offset and the guard bytes on both sides */
+#define TEST_BUF_SIZE       (TEST_MAX_LENGTH + 32)
+#define TEST_GUARD_BYTE     0xA5
+
+/* Called through pointers, so that the compiler can't replace the calls with
+ * its builtins
+ */
+static void *(*volatile uut_memcpy)(void *, const void *, size_t) = memcpy;
+static void *(*volatile uut_memmove)(void *, const void *, size_t) = memmove;
+
+static uint32_t src_words[TEST_BUF_SIZE / sizeof(uint32_t)];
+static uint32_t dst_words[TEST_BUF_SIZE / sizeof(uint32_t)];
+static uint8_t expected[TEST_BUF_SIZE];
+
+static void fill_pattern(uint8_t *buf, size_t size, uint8_t seed)
+{
+    for (size_t idx = 0; idx < size; idx++) {
+        buf[idx] = (uint8_t)(seed + idx * 7 + 1);
+    }
+}
+
+/* Reference copy, correct for any overlap */
+static void reference_move(uint8_t *dest, const uint8_t *src, size_t n)
+{
+    uint8_t tmp[TEST_BUF_SIZE];
+
+    for (size_t idx = 0; idx < n; idx++) {
+        tmp[idx] = src[idx];
+    }
+    for (size_t idx = 0; idx < n; idx++) {
+        dest[idx] = tmp[idx];
+    }
+}
+
+TEST_MATRIX([ 0, 1, 2, 3 ], [ 0, 1, 2, 3 ])
+void test_memcpy_all_alignments_and_lengths(uint32_t src_offset, uint32_t dst_offset)
+{
+    uint8_t *src = (uint8_t *)src_words;
+    uint8_t *dst = (uint8_t *)dst_words;
+    void *ret;
+
+    for (size_t n = 0; n <= TEST_MAX_LENGTH; n++) {
+        /* Prepare */
+        fill_pattern(src, TEST_BUF_SIZE, (uint8_t)n);
+        memset(dst, TEST_GUARD_BYTE, TEST_BUF_SIZE);
+        memset(expected, TEST_GUARD_BYTE, TEST_BUF_SIZE);
+        reference_move(expected + 4 + dst_offset, src + 4 + src_offset, n);
+
+        /* Act */
+        ret = uut_memcpy(dst + 4 + dst_offset, src + 4 + src_offset, n);
+
+        /* Assert: the copy is exact and nothing around it is written */
+        TEST_ASSERT_EQUAL_PTR(dst + 4 + dst_offset, ret);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, dst, TEST_BUF_SIZE);
+    }
+}
+
+TEST_MATRIX([ 1, 2, 3 ], [ 1, 2, 3 ])
+void test_memcpy_tail_merge(uint32_t src_offset, uint32_t tail_length)
+{
+    uint8_t *src = (uint8_t *)src_words;
+    uint8_t *dst = (uint8_t *)dst_words;
+    /* Aligned destination and whole merged words, then a partial word */
+    size_t n = 3 * sizeof(uint32_t) + tail_length;
+
+    /* Prepare: the bytes after the end of the source must not be copied */
+    fill_pattern(src, TEST_BUF_SIZE, 0x10);
+    memset(src + src_offset + n, 0xEE, sizeof(uint32_t));
+    memset(dst, TEST_GUARD_BYTE, TEST_BUF_SIZE);
+    memset(expected, TEST_GUARD_BYTE, TEST_BUF_SIZE);
+    reference_move(expected, src + src_offset, n);
+
+    /* Act */
+    uut_memcpy(dst, src + src_offset, n);
+
+    /* Assert */
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, dst, TEST_BUF_SIZE);
+}
+
+TEST_MATRIX([ 1, 2, 3, 4, 5, 7, 8, 33 ], [ 0, 1, 2, 3 ])
+void test_memmove_overlap_src_above_dest(uint32_t distance, uint32_t dst_offset)
+{
+    uint8_t *buf = (uint8_t *)dst_words;
+
+    for (size_t n = 0; n + distance + dst_offset + 4 <= TEST_BUF_SIZE; n++) {
+        /* Prepare */
+        fill_pattern(buf, TEST_BUF_SIZE, (uint8_t)n);
+        reference_move(expected, buf, TEST_BUF_SIZE);
+        reference_move(expected + dst_offset, expected + dst_offset + distance, n);
+
+        /* Act: copied forward by memcpy() */
+        uut_memmove(buf + dst_offset, buf + dst_offset + distance, n);
+
+        /* Assert */
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, TEST_BUF_SIZE);
+    }
+}
+
+TEST_MATRIX([ 1, 2, 3, 4, 5, 7, 8, 33 ], [ 0, 1, 2, 3 ])
+void test_memmove_overlap_src_below_dest(uint32_t distance, uint32_t src_offset)
+{
+    uint8_t *buf = (uint8_t *)dst_words;
+
+    for (size_t n = 0; n + distance + src_offset + 4 <= TEST_BUF_SIZE; n++) {
+        /* Prepare */
+        fill_pattern(buf, TEST_BUF_SIZE, (uint8_t)n);
+        reference_move(expected, buf, TEST_BUF_SIZE);
+        reference_move(expected + src_offset + distance, expected + src_offset, n);
+
+        /* Act: copied backwards */
+        uut_memmove(buf + src_offset + distance, buf + src_offset, n);
+
+        /* Assert */
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, TEST_BUF_SIZE);
+    }
+}
+
+/*
+ * Not a pass/fail test: prints the time per copy of memcpy() against a byte
+ * loop, for each length and alignment, to compare the two on the host.
+ */
+#define BENCH_ITERATIONS    20000
+#define BENCH_MAX_LENGTH    1024
+
+static uint32_t bench_src[(BENCH_MAX_LENGTH + 8) / sizeof(uint32_t)];
+static uint32_t bench_dst[(BENCH_MAX_LENGTH + 8) / sizeof(uint32_t)];
+
+static void byte_copy(void *dest, const void *src, size_t n)
+{
+    volatile uint8_t *d = dest;
+    const volatile uint8_t *s = src;
+
+    while (n--) {
+        *d++ = *s++;
+    }
+}
+
+static uint64_t elapsed_ns(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (uint64_t)(end.tv_sec - start->tv_sec) * 1000000000u +
+           (uint64_t)end.tv_nsec - (uint64_t)start->tv_nsec;
+}
+
+void test_memcpy_benchmark(void)
+{
+    const size_t lengths[] = {8, 16, 64, 256, BENCH_MAX_LENGTH};
+    const uint32_t offsets[][2] = {{0, 0}, {1, 1}, {1, 0}, {0, 3}, {2, 1}};
+    struct timespec start;
+    uint64_t crt_ns, byte_ns;
+
+    TEST_MESSAGE("length src+ dst+   memcpy ns  byte loop ns");
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+            uint8_t *src = (uint8_t *)bench_src + offsets[o][0];
+            uint8_t *dst = (uint8_t *)bench_dst + offsets[o][1];
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+                uut_memcpy(dst, src, lengths[l]);
+            }
+            crt_ns = elapsed_ns(&start) / BENCH_ITERATIONS;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+                byte_copy(dst, src, lengths[l]);
+            }
+            byte_ns = elapsed_ns(&start) / BENCH_ITERATIONS;
+
+            TEST_PRINTF("%6u %4u %4u %11u %13u", (unsigned int)lengths[l],
+                        (unsigned int)offsets[o][0], (unsigned int)offsets[o][1],
+                        (unsigned int)crt_ns, (unsigned int)byte_ns);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity.h"
+
+/* Covers two iterations of the block loop, plus every tail length */
+#define TEST_MAX_LENGTH     (2 * 8 * sizeof(uint32_t) + 2 * sizeof(uint32_t) + 3)
+/* Room for the largest offset and the guard bytes on both sides */
+#define TEST_BUF_SIZE       (TEST_MAX_LENGTH + 16)
+#define TEST_GUARD_BYTE     0xA5
+
+/* Called through a pointer, so that the compiler can't replace the calls with
+ * its builtin
+ */
+static void *(*volatile uut_memset)(void *, int, size_t) = memset;
+
+static uint32_t buf_words[TEST_BUF_SIZE / sizeof(uint32_t)];
+static uint8_t expected[TEST_BUF_SIZE];
+
+static void reference_set(uint8_t *s, uint8_t c, size_t n)
+{
+    for (size_t idx = 0; idx < n; idx++) {
+        s[idx] = c;
+    }
+}
+
+TEST_MATRIX([ 0, 1, 2, 3 ], [ 0x00, 0x5A, 0xFF, 0x1C3, -1 ])
+void test_memset_all_alignments_and_lengths(uint32_t offset, int c)
+{
+    uint8_t *buf = (uint8_t *)buf_words;
+    void *ret;
+
+    for (size_t n = 0; n <= TEST_MAX_LENGTH; n++) {
+        /* Prepare */
+        reference_set(buf, TEST_GUARD_BYTE, TEST_BUF_SIZE);
+        reference_set(expected, TEST_GUARD_BYTE, TEST_BUF_SIZE);
+        /* Only the low byte of c is used */
+        reference_set(expected + 4 + offset, (uint8_t)c, n);
+
+        /* Act */
+        ret = uut_memset(buf + 4 + offset, c, n);
+
+        /* Assert: the range is set and nothing around it is written */
+        TEST_ASSERT_EQUAL_PTR(buf + 4 + offset, ret);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, TEST_BUF_SIZE);
+    }
+}
+
+/*
+ * Not a pass/fail test: prints the time per call of memset() against a byte
+ * loop, for each length and alignment, to compare the two on the host.
+ */
+#define BENCH_ITERATIONS    20000
+#define BENCH_MAX_LENGTH    1024
+
+static uint32_t bench_buf[(BENCH_MAX_LENGTH + 4) / sizeof(uint32_t)];
+
+static void byte_set(void *s, int c, size_t n)
+{
+    volatile uint8_t *p = s;
+
+    while (n--) {
+        *p++ = (uint8_t)c;
+    }
+}
+
+static uint64_t elapsed_ns(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (uint64_t)(end.tv_sec - start->tv_sec) * 1000000000u +
+           (uint64_t)end.tv_nsec - (uint64_t)start->tv_nsec;
+}
+
+void test_memset_benchmark(void)
+{
+    const size_t lengths[] = {8, 16, 64, 256, BENCH_MAX_LENGTH};
+    const uint32_t offsets[] = {0, 1, 3};
+    struct timespec start;
+    uint64_t crt_ns, byte_ns;
+
+    TEST_MESSAGE("length off+   memset ns  byte loop ns");
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+            uint8_t *buf = (uint8_t *)bench_buf + offsets[o];
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+                uut_memset(buf, (int)i, lengths[l]);
+            }
+            crt_ns = elapsed_ns(&start) / BENCH_ITERATIONS;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+                byte_set(buf, (int)i, lengths[l]);
+            }
+            byte_ns = elapsed_ns(&start) / BENCH_ITERATIONS;
+
+            TEST_PRINTF("%6u %4u %11u %13u", (unsigned int)lengths[l],
+                        (unsigned int)offsets[o], (unsigned int)crt_ns,
+                        (unsigned int)byte_ns);
+        }
+    }
+}
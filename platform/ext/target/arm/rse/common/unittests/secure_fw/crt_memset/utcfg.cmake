@@ -0,0 +1,43 @@
+#-------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Unit under test
+#-------------------------------------------------------------------------------
+set(UNIT_UNDER_TEST ${TFM_ROOT_DIR}/secure_fw/shared/crt_memset.c)
+
+#-------------------------------------------------------------------------------
+# Test suite
+#-------------------------------------------------------------------------------
+
+set(UNIT_TEST_SUITE ${CMAKE_CURRENT_LIST_DIR}/test_crt_memset.c)
+
+#-------------------------------------------------------------------------------
+# Dependencies
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Include dirs
+#-------------------------------------------------------------------------------
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/secure_fw/include)
+
+#-------------------------------------------------------------------------------
+# Compiledefs for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Link libs for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Mocks for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Labels for UT (Optional, tests can be grouped by labels)
+#-------------------------------------------------------------------------------
+list(APPEND UT_LABELS "SECURE_FW")
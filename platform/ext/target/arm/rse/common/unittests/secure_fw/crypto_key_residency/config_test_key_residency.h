@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CONFIG_TEST_KEY_RESIDENCY_H__
+#define __CONFIG_TEST_KEY_RESIDENCY_H__
+
+#define CRYPTO_KEY_RESIDENCY_TRACKED_KEYS      4
+#define CRYPTO_KEY_RESIDENCY_FREE_SLOTS        1
+
+/* Loaded and pinned by tfm_crypto_key_residency_init() */
+#define TEST_PINNED_KEY_ID                     0x100
+#define TEST_KEY_OWNER                         -1
+#define CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS     {{TEST_PINNED_KEY_ID, TEST_KEY_OWNER}}
+
+#endif /* __CONFIG_TEST_KEY_RESIDENCY_H__ */
@@ -0,0 +1,335 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "config_tfm.h"
+#include "tfm_mbedcrypto_include.h"
+
+#include "crypto_library.h"
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+
+/*
+ * Minimal model of the PSA core key slots: a key is loaded into a free slot on
+ * its first use and, when there is none, the PSA core reuses the slot of the
+ * first key which isn't locked by an operation.
+ */
+#define TEST_KEY_SLOT_COUNT 4
+
+struct test_key_slot_t {
+    struct tfm_crypto_key_id_s key;
+    bool is_loaded;
+    bool is_locked;
+};
+
+static struct test_key_slot_t slots[TEST_KEY_SLOT_COUNT];
+static uint32_t key_loads;
+
+static bool slot_matches(const struct test_key_slot_t *slot, mbedtls_svc_key_id_t key)
+{
+    return slot->is_loaded &&
+           (slot->key.key_id == MBEDTLS_SVC_KEY_ID_GET_KEY_ID(key)) &&
+           (slot->key.owner == MBEDTLS_SVC_KEY_ID_GET_OWNER_ID(key));
+}
+
+static struct test_key_slot_t *slot_find(const struct tfm_crypto_key_id_s *key)
+{
+    for (size_t idx = 0; idx < TEST_KEY_SLOT_COUNT; idx++) {
+        if (slots[idx].is_loaded && (slots[idx].key.key_id == key->key_id) &&
+            (slots[idx].key.owner == key->owner)) {
+            return &slots[idx];
+        }
+    }
+
+    return NULL;
+}
+
+tfm_crypto_library_key_id_t tfm_crypto_library_key_id_init(int32_t owner, psa_key_id_t key_id)
+{
+    return mbedtls_svc_key_id_make(owner, key_id);
+}
+
+psa_status_t psa_get_key_attributes(mbedtls_svc_key_id_t key, psa_key_attributes_t *attributes)
+{
+    struct test_key_slot_t *free_slot = NULL;
+    struct test_key_slot_t *reused_slot = NULL;
+
+    (void)attributes;
+
+    for (size_t idx = 0; idx < TEST_KEY_SLOT_COUNT; idx++) {
+        if (slot_matches(&slots[idx], key)) {
+            return PSA_SUCCESS;
+        }
+        if (!slots[idx].is_loaded && (free_slot == NULL)) {
+            free_slot = &slots[idx];
+        }
+        if (slots[idx].is_loaded && !slots[idx].is_locked && (reused_slot == NULL)) {
+            reused_slot = &slots[idx];
+        }
+    }
+
+    if (free_slot == NULL) {
+        free_slot = reused_slot;
+    }
+    if (free_slot == NULL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    free_slot->key.key_id = MBEDTLS_SVC_KEY_ID_GET_KEY_ID(key);
+    free_slot->key.owner = MBEDTLS_SVC_KEY_ID_GET_OWNER_ID(key);
+    free_slot->is_loaded = true;
+    free_slot->is_locked = false;
+    key_loads++;
+
+    return PSA_SUCCESS;
+}
+
+void psa_reset_key_attributes(psa_key_attributes_t *attributes)
+{
+    (void)attributes;
+}
+
+psa_status_t psa_purge_key(mbedtls_svc_key_id_t key)
+{
+    for (size_t idx = 0; idx < TEST_KEY_SLOT_COUNT; idx++) {
+        if (slot_matches(&slots[idx], key)) {
+            if (!slots[idx].is_locked) {
+                slots[idx].is_loaded = false;
+            }
+            return PSA_SUCCESS;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+void mbedtls_psa_get_stats(mbedtls_psa_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    for (size_t idx = 0; idx < TEST_KEY_SLOT_COUNT; idx++) {
+        if (slots[idx].is_loaded) {
+            stats->MBEDTLS_PRIVATE(persistent_slots)++;
+        } else {
+            stats->MBEDTLS_PRIVATE(empty_slots)++;
+        }
+    }
+}
+
+/* Issues a request using a key the way tfm_crypto_call_srv() does */
+static void use_key(psa_key_id_t key_id)
+{
+    struct tfm_crypto_key_id_s key = {key_id, TEST_KEY_OWNER};
+    psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+    psa_status_t status;
+
+    tfm_crypto_key_residency_prepare(&key, TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_SID);
+    status = psa_get_key_attributes(tfm_crypto_library_key_id_init(key.owner, key.key_id),
+                                    &attr);
+    tfm_crypto_key_residency_record(&key, TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_SID, status);
+}
+
+static bool is_loaded(psa_key_id_t key_id)
+{
+    struct tfm_crypto_key_id_s key = {key_id, TEST_KEY_OWNER};
+
+    return slot_find(&key) != NULL;
+}
+
+#define TEST_KEY_A 0x200
+#define TEST_KEY_B 0x201
+#define TEST_KEY_C 0x202
+#define TEST_KEY_D 0x203
+
+void setUp(void)
+{
+    memset(slots, 0, sizeof(slots));
+    key_loads = 0;
+
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, tfm_crypto_key_residency_init());
+}
+
+void tearDown(void)
+{
+    const psa_key_id_t keys[] = {TEST_PINNED_KEY_ID, TEST_KEY_A, TEST_KEY_B,
+                                 TEST_KEY_C, TEST_KEY_D};
+
+    /* Destroying a key drops its entry, pinned or not */
+    for (size_t idx = 0; idx < sizeof(keys) / sizeof(keys[0]); idx++) {
+        struct tfm_crypto_key_id_s key = {keys[idx], TEST_KEY_OWNER};
+
+        tfm_crypto_key_residency_record(&key, TFM_CRYPTO_DESTROY_KEY_SID, PSA_SUCCESS);
+    }
+}
+
+void test_init_loads_prefetch_keys(void)
+{
+    TEST_ASSERT_TRUE(is_loaded(TEST_PINNED_KEY_ID));
+    TEST_ASSERT_EQUAL_UINT32(1, key_loads);
+}
+
+void test_prepare_evicts_least_used_key(void)
+{
+    struct tfm_crypto_key_residency_stats_t before, after;
+
+    /* Prepare: B is the least used key and no slot is free */
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_C);
+    use_key(TEST_KEY_C);
+    use_key(TEST_KEY_B);
+    tfm_crypto_key_residency_get_stats(&before);
+
+    /* Act */
+    use_key(TEST_KEY_D);
+
+    /* Assert */
+    tfm_crypto_key_residency_get_stats(&after);
+    TEST_ASSERT_FALSE(is_loaded(TEST_KEY_B));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_A));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_C));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_D));
+    TEST_ASSERT_EQUAL_UINT32(before.evictions + 1, after.evictions);
+    TEST_ASSERT_EQUAL_UINT32(before.misses + 1, after.misses);
+}
+
+void test_prepare_never_evicts_requested_key(void)
+{
+    struct tfm_crypto_key_residency_stats_t before, after;
+    uint32_t loads;
+
+    /* Prepare: B is the least used resident key and no slot is free */
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_C);
+    use_key(TEST_KEY_C);
+    use_key(TEST_KEY_B);
+    loads = key_loads;
+    tfm_crypto_key_residency_get_stats(&before);
+
+    /* Act */
+    use_key(TEST_KEY_B);
+
+    /* Assert: A is purged instead, and B is used without being reloaded */
+    tfm_crypto_key_residency_get_stats(&after);
+    TEST_ASSERT_FALSE(is_loaded(TEST_KEY_A));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_B));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_C));
+    TEST_ASSERT_EQUAL_UINT32(loads, key_loads);
+    TEST_ASSERT_EQUAL_UINT32(before.hits + 1, after.hits);
+    TEST_ASSERT_EQUAL_UINT32(before.misses, after.misses);
+}
+
+void test_prepare_never_evicts_pinned_key(void)
+{
+    /* Prepare: the pinned key is never used, so it is the least used one */
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_B);
+    use_key(TEST_KEY_B);
+    use_key(TEST_KEY_C);
+
+    /* Act */
+    use_key(TEST_KEY_D);
+
+    /* Assert */
+    TEST_ASSERT_TRUE(is_loaded(TEST_PINNED_KEY_ID));
+    TEST_ASSERT_FALSE(is_loaded(TEST_KEY_C));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_D));
+}
+
+void test_prepare_skips_locked_key(void)
+{
+    struct tfm_crypto_key_id_s key_b = {TEST_KEY_B, TEST_KEY_OWNER};
+    struct tfm_crypto_key_residency_stats_t before, after;
+
+    /* Prepare: B is the least used key but is in use by an operation */
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_C);
+    use_key(TEST_KEY_C);
+    use_key(TEST_KEY_B);
+    slot_find(&key_b)->is_locked = true;
+    tfm_crypto_key_residency_get_stats(&before);
+
+    /* Act */
+    use_key(TEST_KEY_D);
+
+    /* Assert: purging B frees nothing, so A is purged next */
+    tfm_crypto_key_residency_get_stats(&after);
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_B));
+    TEST_ASSERT_FALSE(is_loaded(TEST_KEY_A));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_C));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_D));
+    TEST_ASSERT_EQUAL_UINT32(before.evictions + 1, after.evictions);
+}
+
+void test_prepare_stops_when_nothing_can_be_purged(void)
+{
+    struct tfm_crypto_key_id_s key = {TEST_KEY_A, TEST_KEY_OWNER};
+    struct tfm_crypto_key_residency_stats_t before, after;
+
+    /* Prepare: only the pinned key and the requested key are resident */
+    use_key(TEST_KEY_A);
+    tfm_crypto_key_residency_get_stats(&before);
+    slots[2].is_loaded = true;
+    slots[2].is_locked = true;
+    slots[3].is_loaded = true;
+    slots[3].is_locked = true;
+
+    /* Act */
+    tfm_crypto_key_residency_prepare(&key, TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_SID);
+
+    /* Assert */
+    tfm_crypto_key_residency_get_stats(&after);
+    TEST_ASSERT_TRUE(is_loaded(TEST_PINNED_KEY_ID));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_A));
+    TEST_ASSERT_EQUAL_UINT32(before.evictions, after.evictions);
+}
+
+void test_record_purge_marks_key_not_resident(void)
+{
+    struct tfm_crypto_key_id_s key = {TEST_KEY_A, TEST_KEY_OWNER};
+    struct tfm_crypto_key_residency_stats_t before, after;
+
+    /* Prepare */
+    use_key(TEST_KEY_A);
+    (void)psa_purge_key(tfm_crypto_library_key_id_init(key.owner, key.key_id));
+    tfm_crypto_key_residency_record(&key, TFM_CRYPTO_PURGE_KEY_SID, PSA_SUCCESS);
+    tfm_crypto_key_residency_get_stats(&before);
+
+    /* Act */
+    use_key(TEST_KEY_A);
+
+    /* Assert */
+    tfm_crypto_key_residency_get_stats(&after);
+    TEST_ASSERT_EQUAL_UINT32(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_UINT32(before.hits, after.hits);
+}
+
+void test_prepare_ignores_unmanaged_keys(void)
+{
+    struct tfm_crypto_key_id_s key = {PSA_KEY_ID_VENDOR_MIN, TEST_KEY_OWNER};
+
+    /* Prepare: leave no slot free */
+    use_key(TEST_KEY_A);
+    use_key(TEST_KEY_B);
+    slots[3].is_loaded = true;
+
+    /* Act */
+    tfm_crypto_key_residency_prepare(&key, TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_SID);
+
+    /* Assert */
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_A));
+    TEST_ASSERT_TRUE(is_loaded(TEST_KEY_B));
+}
@@ -0,0 +1,55 @@
+#-------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+set(CRYPTO_DIR ${TFM_ROOT_DIR}/secure_fw/partitions/crypto)
+set(MBEDCRYPTO_CONFIG_DIR ${TFM_ROOT_DIR}/lib/ext/mbedcrypto/mbedcrypto_config)
+
+#-------------------------------------------------------------------------------
+# Unit under test
+#-------------------------------------------------------------------------------
+set(UNIT_UNDER_TEST ${CRYPTO_DIR}/crypto_key_residency.c)
+
+#-------------------------------------------------------------------------------
+# Test suite
+#-------------------------------------------------------------------------------
+
+set(UNIT_TEST_SUITE ${CMAKE_CURRENT_LIST_DIR}/test_crypto_key_residency.c)
+
+#-------------------------------------------------------------------------------
+# Dependencies
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Include dirs
+#-------------------------------------------------------------------------------
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${CRYPTO_DIR})
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/secure_fw/include)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/secure_fw/spm/include)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/config)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/interface/include)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/platform/include)
+
+#-------------------------------------------------------------------------------
+# Compiledefs for UUT
+#-------------------------------------------------------------------------------
+list(APPEND UNIT_TEST_COMPILE_DEFS PROJECT_CONFIG_HEADER_FILE="${CMAKE_CURRENT_LIST_DIR}/config_test_key_residency.h")
+list(APPEND UNIT_TEST_COMPILE_DEFS MBEDTLS_CONFIG_FILE="${MBEDCRYPTO_CONFIG_DIR}/tfm_mbedcrypto_config_default.h")
+list(APPEND UNIT_TEST_COMPILE_DEFS MBEDTLS_PSA_CRYPTO_CONFIG_FILE="${MBEDCRYPTO_CONFIG_DIR}/crypto_config_default.h")
+list(APPEND UNIT_TEST_COMPILE_DEFS PLATFORM_DEFAULT_CRYPTO_KEYS)
+
+#-------------------------------------------------------------------------------
+# Link libs for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Mocks for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Labels for UT (Optional, tests can be grouped by labels)
+#-------------------------------------------------------------------------------
+list(APPEND UT_LABELS "SECURE_FW")
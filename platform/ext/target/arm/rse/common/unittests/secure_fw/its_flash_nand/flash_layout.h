@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Simulated NAND flash device, implemented by the test */
+#define TEST_NAND_BLOCK_SIZE            (0x1000)
+#define TEST_NAND_NUM_BLOCKS            (8)
+
+#define TFM_HAL_ITS_FLASH_DRIVER        UNITTEST_NAND_FLASH_DEV
+#define TFM_HAL_ITS_FLASH_AREA_ADDR     (0x0)
+#define TFM_HAL_ITS_FLASH_AREA_SIZE     (TEST_NAND_NUM_BLOCKS * TEST_NAND_BLOCK_SIZE)
+#define TFM_HAL_ITS_SECTORS_PER_BLOCK   (1)
+/* Larger than 16, so ITS uses the NAND backend */
+#define TFM_HAL_ITS_PROGRAM_UNIT        (0x200)
+#define ITS_FLASH_NAND_BUF_SIZE         TEST_NAND_BLOCK_SIZE
+
+#endif /* __FLASH_LAYOUT_H__ */
@@ -0,0 +1,454 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Driver_Flash.h"
+#include "flash_layout.h"
+#include "flash_fs/its_flash_fs.h"
+#include "its_flash_nand.h"
+
+#include "unity.h"
+
+#define TEST_MAX_CACHE_ENTRIES  8
+#define TEST_NUM_FILES          8
+#define TEST_MAX_FILE_SIZE      512
+#define TEST_ERASE_VAL          0xFF
+/* The file system is loaded from flash again after this many operations */
+#define TEST_OPS_PER_BOOT       5000
+
+/* Kinds of file system operations done by the workload */
+enum test_op_t {
+    TEST_OP_WRITE,
+    TEST_OP_READ,
+    TEST_OP_DELETE,
+    TEST_OP_COUNT
+};
+
+/* Accesses to the simulated device */
+static struct {
+    uint32_t read_calls;
+    uint32_t read_bytes;
+    uint32_t program_calls;
+    uint32_t erase_calls;
+    uint32_t misaligned_accesses;
+    uint32_t programs_of_unerased;
+} flash_stats;
+
+static uint8_t flash_mem[TFM_HAL_ITS_FLASH_AREA_SIZE];
+
+/* Simulated NAND flash, with 32-bit data items */
+static ARM_FLASH_CAPABILITIES UNITTEST_NAND_Flash_GetCapabilities(void)
+{
+    static const ARM_FLASH_CAPABILITIES Caps = {
+        .data_width = 2u,
+        .erase_chip = 0u,
+        .event_ready = 0u,
+        .reserved = 0u,
+    };
+
+    return Caps;
+}
+
+static int32_t UNITTEST_NAND_Flash_Initialize(ARM_Flash_SignalEvent_t cb_event)
+{
+    (void)(cb_event);
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t UNITTEST_NAND_Flash_ReadData(uint32_t addr, void *data,
+                                            uint32_t cnt)
+{
+    const uint32_t size = cnt * sizeof(uint32_t);
+
+    if ((addr % sizeof(uint32_t)) != 0) {
+        flash_stats.misaligned_accesses++;
+    }
+    if (addr + size > sizeof(flash_mem)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    flash_stats.read_calls++;
+    flash_stats.read_bytes += size;
+    memcpy(data, &flash_mem[addr], size);
+
+    return (int32_t)cnt;
+}
+
+static int32_t UNITTEST_NAND_Flash_ProgramData(uint32_t addr, const void *data,
+                                               uint32_t cnt)
+{
+    const uint32_t size = cnt * sizeof(uint32_t);
+
+    if ((addr % sizeof(uint32_t)) != 0) {
+        flash_stats.misaligned_accesses++;
+    }
+    if (addr + size > sizeof(flash_mem)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    /* NAND pages can only be programmed once after an erase */
+    for (uint32_t idx = 0; idx < size; idx++) {
+        if (flash_mem[addr + idx] != TEST_ERASE_VAL) {
+            flash_stats.programs_of_unerased++;
+            break;
+        }
+    }
+
+    flash_stats.program_calls++;
+    memcpy(&flash_mem[addr], data, size);
+
+    return (int32_t)cnt;
+}
+
+static int32_t UNITTEST_NAND_Flash_EraseSector(uint32_t addr)
+{
+    if ((addr % TEST_NAND_BLOCK_SIZE) != 0 || addr >= sizeof(flash_mem)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    flash_stats.erase_calls++;
+    memset(&flash_mem[addr], TEST_ERASE_VAL, TEST_NAND_BLOCK_SIZE);
+
+    return ARM_DRIVER_OK;
+}
+
+ARM_DRIVER_FLASH UNITTEST_NAND_FLASH_DEV = {
+    .GetCapabilities = UNITTEST_NAND_Flash_GetCapabilities,
+    .Initialize = UNITTEST_NAND_Flash_Initialize,
+    .ReadData = UNITTEST_NAND_Flash_ReadData,
+    .ProgramData = UNITTEST_NAND_Flash_ProgramData,
+    .EraseSector = UNITTEST_NAND_Flash_EraseSector,
+};
+
+static uint8_t cache_buf[TEST_MAX_CACHE_ENTRIES][ITS_FLASH_NAND_BUF_SIZE];
+static struct its_flash_nand_cache_entry_t cache[TEST_MAX_CACHE_ENTRIES];
+static struct its_flash_nand_dev_t nand_dev;
+
+static const struct its_flash_fs_config_t fs_cfg = {
+    .flash_dev = &nand_dev,
+    .flash_area_addr = TFM_HAL_ITS_FLASH_AREA_ADDR,
+    .sector_size = TEST_NAND_BLOCK_SIZE,
+    .block_size = TEST_NAND_BLOCK_SIZE,
+    .num_blocks = TEST_NAND_NUM_BLOCKS,
+    .program_unit = 1,
+    .max_file_size = TEST_MAX_FILE_SIZE,
+    .max_num_files = TEST_NUM_FILES + 1,
+    .erase_val = TEST_ERASE_VAL,
+};
+
+static struct its_flash_fs_ctx_t fs_ctx;
+
+/* Expected content of the files */
+static struct {
+    uint8_t data[TEST_MAX_FILE_SIZE];
+    size_t size;
+    bool exists;
+} model[TEST_NUM_FILES];
+
+/* Device accesses done by the workload, for each kind of operation */
+struct workload_stats_t {
+    uint32_t ops[TEST_OP_COUNT];
+    uint32_t read_calls[TEST_OP_COUNT];
+    uint32_t read_bytes[TEST_OP_COUNT];
+    uint32_t program_calls[TEST_OP_COUNT];
+};
+
+/* xorshift32, so that the workload is the same with every C library */
+static uint32_t prng_state;
+
+static uint32_t prng_next(void)
+{
+    prng_state ^= prng_state << 13;
+    prng_state ^= prng_state >> 17;
+    prng_state ^= prng_state << 5;
+
+    return prng_state;
+}
+
+/* Emulates a boot: the RAM state is lost and the file system is loaded from
+ * flash. As in the ITS service, the file system is created if the flash
+ * doesn't hold a valid one, which is only expected on the first boot.
+ */
+static void boot_file_system(size_t cache_entries, bool first_boot)
+{
+    psa_status_t status;
+
+    memset(cache, 0, sizeof(cache));
+    memset(&nand_dev, 0, sizeof(nand_dev));
+    nand_dev.driver = &UNITTEST_NAND_FLASH_DEV;
+    nand_dev.cache = cache;
+    nand_dev.cache_buf = &cache_buf[0][0];
+    nand_dev.cache_entries = cache_entries;
+    nand_dev.buf_size = ITS_FLASH_NAND_BUF_SIZE;
+
+    memset(&fs_ctx, 0, sizeof(fs_ctx));
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_init_ctx(&fs_ctx, &fs_cfg, &its_flash_fs_ops_nand));
+
+    status = its_flash_fs_prepare(&fs_ctx);
+    if (first_boot && (status != PSA_SUCCESS)) {
+        TEST_ASSERT_EQUAL(PSA_SUCCESS, its_flash_fs_wipe_all(&fs_ctx));
+        status = its_flash_fs_prepare(&fs_ctx);
+    }
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+}
+
+static void do_write(const uint8_t *fid, uint32_t file)
+{
+    struct its_flash_fs_file_info_t info = {0};
+    uint8_t data[TEST_MAX_FILE_SIZE];
+    size_t size = prng_next() % TEST_MAX_FILE_SIZE;
+
+    for (size_t idx = 0; idx < size; idx++) {
+        data[idx] = (uint8_t)prng_next();
+    }
+
+    info.size_current = size;
+    info.size_max = TEST_MAX_FILE_SIZE;
+    info.flags = ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE;
+
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_file_write(&fs_ctx, fid, &info, size, 0, data));
+
+    memcpy(model[file].data, data, size);
+    model[file].size = size;
+    model[file].exists = true;
+}
+
+static void do_read(const uint8_t *fid, uint32_t file)
+{
+    struct its_flash_fs_file_info_t info;
+    uint8_t data[TEST_MAX_FILE_SIZE];
+    psa_status_t status;
+
+    status = its_flash_fs_file_get_info(&fs_ctx, fid, &info);
+    if (!model[file].exists) {
+        TEST_ASSERT_EQUAL(PSA_ERROR_DOES_NOT_EXIST, status);
+        return;
+    }
+
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(model[file].size, info.size_current);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_file_read(&fs_ctx, fid, model[file].size, 0,
+                                             data));
+    if (model[file].size > 0) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(model[file].data, data, model[file].size);
+    }
+}
+
+static void do_delete(const uint8_t *fid, uint32_t file)
+{
+    if (!model[file].exists) {
+        return;
+    }
+
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, its_flash_fs_file_delete(&fs_ctx, fid));
+    model[file].exists = false;
+}
+
+/* Random writes, reads and deletes of a few files, checked against a model of
+ * their content, with a reboot every TEST_OPS_PER_BOOT operations.
+ */
+static void run_workload(size_t cache_entries, uint32_t op_count,
+                         struct workload_stats_t *stats)
+{
+    uint8_t fid[ITS_FILE_ID_SIZE];
+    uint32_t read_calls, read_bytes, program_calls;
+    uint32_t file;
+    enum test_op_t op;
+
+    memset(&flash_stats, 0, sizeof(flash_stats));
+    memset(flash_mem, TEST_ERASE_VAL, sizeof(flash_mem));
+    memset(model, 0, sizeof(model));
+    memset(stats, 0, sizeof(*stats));
+    prng_state = 0x2545F491;
+
+    boot_file_system(cache_entries, true);
+
+    for (uint32_t idx = 0; idx < op_count; idx++) {
+        file = prng_next() % TEST_NUM_FILES;
+        /* Twice as many reads as writes or deletes */
+        switch (prng_next() % 4) {
+        case 0:
+            op = TEST_OP_WRITE;
+            break;
+        case 1:
+            op = TEST_OP_DELETE;
+            break;
+        default:
+            op = TEST_OP_READ;
+            break;
+        }
+
+        memset(fid, 0, sizeof(fid));
+        fid[0] = (uint8_t)(file + 1);
+
+        read_calls = flash_stats.read_calls;
+        read_bytes = flash_stats.read_bytes;
+        program_calls = flash_stats.program_calls;
+
+        switch (op) {
+        case TEST_OP_WRITE:
+            do_write(fid, file);
+            break;
+        case TEST_OP_READ:
+            do_read(fid, file);
+            break;
+        default:
+            do_delete(fid, file);
+            break;
+        }
+
+        stats->ops[op]++;
+        stats->read_calls[op] += flash_stats.read_calls - read_calls;
+        stats->read_bytes[op] += flash_stats.read_bytes - read_bytes;
+        stats->program_calls[op] += flash_stats.program_calls - program_calls;
+
+        if ((idx % TEST_OPS_PER_BOOT) == (TEST_OPS_PER_BOOT - 1)) {
+            boot_file_system(cache_entries, false);
+        }
+    }
+}
+
+void setUp(void)
+{
+    memset(&flash_stats, 0, sizeof(flash_stats));
+    memset(flash_mem, TEST_ERASE_VAL, sizeof(flash_mem));
+
+    memset(cache, 0, sizeof(cache));
+    memset(&nand_dev, 0, sizeof(nand_dev));
+    nand_dev.driver = &UNITTEST_NAND_FLASH_DEV;
+    nand_dev.cache = cache;
+    nand_dev.cache_buf = &cache_buf[0][0];
+    nand_dev.cache_entries = TEST_MAX_CACHE_ENTRIES;
+    nand_dev.buf_size = ITS_FLASH_NAND_BUF_SIZE;
+}
+
+TEST_CASE(0)
+TEST_CASE(1)
+void test_its_flash_nand_init_rejects_small_cache(uint32_t cache_entries)
+{
+    nand_dev.cache_entries = cache_entries;
+
+    TEST_ASSERT_EQUAL(PSA_ERROR_PROGRAMMER_ERROR,
+                      its_flash_fs_ops_nand.init(&fs_cfg));
+}
+
+void test_its_flash_nand_read_extends_cached_range(void)
+{
+    uint8_t *block = &flash_mem[1 * TEST_NAND_BLOCK_SIZE];
+    uint8_t data[TEST_NAND_BLOCK_SIZE];
+
+    /* Prepare: only the middle of the block is cached */
+    for (size_t idx = 0; idx < TEST_NAND_BLOCK_SIZE; idx++) {
+        block[idx] = (uint8_t)(idx * 7 + 1);
+    }
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, its_flash_fs_ops_nand.init(&fs_cfg));
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_ops_nand.read(&fs_cfg, 1, data, 0x800, 0x10));
+
+    /* Act: reads before and after the cached range */
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_ops_nand.read(&fs_cfg, 1, data, 0x7F0, 0x20));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&block[0x7F0], data, 0x20);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_ops_nand.read(&fs_cfg, 1, data, 0,
+                                                 TEST_NAND_BLOCK_SIZE));
+
+    /* Assert */
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(block, data, TEST_NAND_BLOCK_SIZE);
+}
+
+void test_its_flash_nand_erase_drops_cached_block(void)
+{
+    uint8_t *block = &flash_mem[1 * TEST_NAND_BLOCK_SIZE];
+    uint8_t expected[TEST_NAND_BLOCK_SIZE];
+    uint8_t data[TEST_NAND_BLOCK_SIZE];
+
+    /* Prepare: the programmed block is cached */
+    memset(block, 0x5A, TEST_NAND_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, its_flash_fs_ops_nand.init(&fs_cfg));
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_ops_nand.read(&fs_cfg, 1, data, 0,
+                                                 TEST_NAND_BLOCK_SIZE));
+
+    /* Act */
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, its_flash_fs_ops_nand.erase(&fs_cfg, 1));
+    TEST_ASSERT_EQUAL(PSA_SUCCESS,
+                      its_flash_fs_ops_nand.read(&fs_cfg, 1, data, 0,
+                                                 TEST_NAND_BLOCK_SIZE));
+
+    /* Assert: the erased content is read, not the stale cached one */
+    memset(expected, TEST_ERASE_VAL, sizeof(expected));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, TEST_NAND_BLOCK_SIZE);
+}
+
+TEST_MATRIX([ 2, 3, 4, 8 ])
+void test_its_flash_nand_workload_matches_model(uint32_t cache_entries)
+{
+    struct workload_stats_t stats;
+
+    /* Act: the content of the files is checked after each operation */
+    run_workload(cache_entries, 4 * TEST_OPS_PER_BOOT, &stats);
+
+    /* Assert: the device was only accessed as NAND flash allows */
+    TEST_ASSERT_EQUAL(0, flash_stats.misaligned_accesses);
+    TEST_ASSERT_EQUAL(0, flash_stats.programs_of_unerased);
+}
+
+TEST_CASE(2)
+TEST_CASE(4)
+void test_its_flash_nand_reads_are_cached(uint32_t cache_entries)
+{
+    uint8_t fid[ITS_FILE_ID_SIZE] = {1};
+    uint32_t read_calls;
+
+    /* Prepare */
+    boot_file_system(cache_entries, true);
+    prng_state = 0x2545F491;
+    memset(model, 0, sizeof(model));
+    do_write(fid, 0);
+    do_read(fid, 0);
+
+    /* Act: the blocks used by the file are already cached */
+    read_calls = flash_stats.read_calls;
+    do_read(fid, 0);
+
+    /* Assert */
+    TEST_ASSERT_EQUAL(read_calls, flash_stats.read_calls);
+}
+
+/*
+ * Not a pass/fail test: prints the device accesses per file system operation
+ * of the random workload for several cache sizes, to compare them on the host.
+ */
+void test_its_flash_nand_cache_benchmark(void)
+{
+    const size_t cache_sizes[] = {2, 3, 4, 8};
+    const char *const op_names[TEST_OP_COUNT] = {"write", "read", "delete"};
+    struct workload_stats_t stats;
+
+    TEST_MESSAGE("entries     op  ReadData/op  bytes read/op  ProgramData/op");
+    for (size_t c = 0; c < sizeof(cache_sizes) / sizeof(cache_sizes[0]); c++) {
+        run_workload(cache_sizes[c], 4 * TEST_OPS_PER_BOOT, &stats);
+
+        for (size_t op = 0; op < TEST_OP_COUNT; op++) {
+            TEST_PRINTF("%7u %6s %12u.%02u %14u %15u.%02u",
+                        (unsigned int)cache_sizes[c], op_names[op],
+                        (unsigned int)(stats.read_calls[op] / stats.ops[op]),
+                        (unsigned int)((stats.read_calls[op] * 100u / stats.ops[op]) % 100u),
+                        (unsigned int)(stats.read_bytes[op] / stats.ops[op]),
+                        (unsigned int)(stats.program_calls[op] / stats.ops[op]),
+                        (unsigned int)((stats.program_calls[op] * 100u / stats.ops[op]) % 100u));
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#-------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+set(ITS_DIR ${TFM_ROOT_DIR}/secure_fw/partitions/internal_trusted_storage)
+
+#-------------------------------------------------------------------------------
+# Unit under test
+#-------------------------------------------------------------------------------
+set(UNIT_UNDER_TEST ${ITS_DIR}/flash/its_flash_nand.c)
+list(APPEND UNIT_UNDER_TEST ${ITS_DIR}/flash_fs/its_flash_fs.c)
+list(APPEND UNIT_UNDER_TEST ${ITS_DIR}/flash_fs/its_flash_fs_dblock.c)
+list(APPEND UNIT_UNDER_TEST ${ITS_DIR}/flash_fs/its_flash_fs_mblock.c)
+list(APPEND UNIT_UNDER_TEST ${ITS_DIR}/its_utils.c)
+
+#-------------------------------------------------------------------------------
+# Test suite
+#-------------------------------------------------------------------------------
+
+set(UNIT_TEST_SUITE ${CMAKE_CURRENT_LIST_DIR}/test_its_flash_nand.c)
+
+#-------------------------------------------------------------------------------
+# Dependencies
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Include dirs
+#-------------------------------------------------------------------------------
+# The test's flash_layout.h describes the simulated NAND flash device
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${CMAKE_CURRENT_LIST_DIR})
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${ITS_DIR})
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${ITS_DIR}/flash)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/secure_fw/include)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/secure_fw/spm/include)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/config)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/interface/include)
+list(APPEND UNIT_TEST_INCLUDE_DIRS ${TFM_ROOT_DIR}/platform/include)
+
+#-------------------------------------------------------------------------------
+# Compiledefs for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Link libs for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Mocks for UUT
+#-------------------------------------------------------------------------------
+
+#-------------------------------------------------------------------------------
+# Labels for UT (Optional, tests can be grouped by labels)
+#-------------------------------------------------------------------------------
+list(APPEND UT_LABELS "SECURE_FW")
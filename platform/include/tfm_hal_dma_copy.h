@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_HAL_DMA_COPY_H__
+#define __TFM_HAL_DMA_COPY_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "tfm_hal_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Retrieve the smallest copy the platform DMA is worth being used for.
+ *        Shorter copies are done by the CPU.
+ *
+ * \return Size in bytes
+ */
+size_t tfm_hal_dma_copy_min_size(void);
+
+/**
+ * \brief Start copying memory with the platform DMA and return without
+ *        waiting for the copy to complete. Only one copy can be in flight.
+ *
+ * \note  The caller has already checked that the accesses are permitted, the
+ *        DMA must be configured to be able to access both buffers.
+ *
+ * \param[out] dest  Destination of the copy
+ * \param[in]  src   Source of the copy
+ * \param[in]  n     Number of bytes to copy
+ *
+ * \retval TFM_HAL_SUCCESS              The copy has been started
+ * \retval TFM_HAL_ERROR_NOT_SUPPORTED  The DMA can't do this copy, for
+ *                                      example because of the alignment
+ * \retval TFM_HAL_ERROR_BAD_STATE      A copy is already in flight
+ */
+enum tfm_hal_status_t tfm_hal_dma_copy_start(void *dest, const void *src, size_t n);
+
+/**
+ * \brief Check whether the copy started last has completed.
+ *
+ * \return true if no copy is in flight, false otherwise
+ */
+bool tfm_hal_dma_copy_is_done(void);
+
+/**
+ * \brief Wait for the copy started last to complete.
+ *
+ * \retval TFM_HAL_SUCCESS        The copy has completed
+ * \retval TFM_HAL_ERROR_GENERIC  The DMA reported an error
+ */
+enum tfm_hal_status_t tfm_hal_dma_copy_wait(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_HAL_DMA_COPY_H__ */
@@ -19,4 +19,8 @@
 #error "Invalid config: NOT CRYPTO_NV_SEED AND NOT CRYPTO_EXT_RNG!"
 #endif
 
+#if defined(CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE) && (TFM_BUILTIN_MAX_DERIVED_SUBKEYS == 0)
+#error "Invalid config: CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE AND NOT TFM_BUILTIN_MAX_DERIVED_SUBKEYS!"
+#endif
+
 #endif /* __CONFIG_PARTITION_CRYPTO_H__ */
@@ -27,6 +27,10 @@
 #include "crypto_hw.h"
 #endif /* CRYPTO_HW_ACCELERATOR */
 
+#ifdef CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE
+#include "tfm_builtin_key_loader.h"
+#endif /* CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE */
+
 #include <string.h>
 #include "psa/framework_feature.h"
 #include "psa/service.h"
@@ -192,6 +196,13 @@ static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
 }
 #endif /* PSA_FRAMEWORK_HAS_MM_IOVEC == 1 */
 
+#if CRYPTO_BATCH_MODULE_ENABLED
+static psa_status_t tfm_crypto_batch_interface(psa_invec in_vec[],
+                                               size_t in_len,
+                                               psa_outvec out_vec[],
+                                               size_t out_len);
+#endif /* CRYPTO_BATCH_MODULE_ENABLED */
+
 static psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
                                               size_t in_len,
                                               psa_outvec out_vec[],
@@ -211,7 +222,8 @@ static psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
     group_id = TFM_CRYPTO_GET_GROUP_ID(iov->function_id);
 
     is_key_required = !((group_id == TFM_CRYPTO_GROUP_ID_HASH) ||
-                        (group_id == TFM_CRYPTO_GROUP_ID_RANDOM));
+                        (group_id == TFM_CRYPTO_GROUP_ID_RANDOM) ||
+                        (group_id == TFM_CRYPTO_GROUP_ID_BATCH));
 
     if (is_key_required) {
         status = tfm_crypto_get_caller_id(&caller_id);
@@ -225,36 +237,166 @@ static psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
         encoded_key.owner = caller_id;
     }
 
+#if CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0
+    if (is_key_required) {
+        tfm_crypto_key_residency_prepare(&encoded_key, iov->function_id);
+    }
+#endif /* CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0 */
+
     /* Dispatch to each sub-module based on the Group ID */
     switch (group_id) {
     case TFM_CRYPTO_GROUP_ID_KEY_MANAGEMENT:
-        return tfm_crypto_key_management_interface(in_vec, out_vec,
-                                                   &encoded_key);
+        status = tfm_crypto_key_management_interface(in_vec, out_vec,
+                                                     &encoded_key);
+        break;
     case TFM_CRYPTO_GROUP_ID_HASH:
-        return tfm_crypto_hash_interface(in_vec, out_vec);
+        status = tfm_crypto_hash_interface(in_vec, out_vec);
+        break;
     case TFM_CRYPTO_GROUP_ID_MAC:
-        return tfm_crypto_mac_interface(in_vec, out_vec, &encoded_key);
+        status = tfm_crypto_mac_interface(in_vec, out_vec, &encoded_key);
+        break;
     case TFM_CRYPTO_GROUP_ID_CIPHER:
-        return tfm_crypto_cipher_interface(in_vec, out_vec, &encoded_key);
+        status = tfm_crypto_cipher_interface(in_vec, out_vec, &encoded_key);
+        break;
     case TFM_CRYPTO_GROUP_ID_AEAD:
-        return tfm_crypto_aead_interface(in_vec, out_vec, &encoded_key);
+        status = tfm_crypto_aead_interface(in_vec, out_vec, &encoded_key);
+        break;
     case TFM_CRYPTO_GROUP_ID_ASYM_SIGN:
-        return tfm_crypto_asymmetric_sign_interface(in_vec, out_vec,
-                                                    &encoded_key);
+        status = tfm_crypto_asymmetric_sign_interface(in_vec, out_vec,
+                                                      &encoded_key);
+        break;
     case TFM_CRYPTO_GROUP_ID_ASYM_ENCRYPT:
-        return tfm_crypto_asymmetric_encrypt_interface(in_vec, out_vec,
-                                                       &encoded_key);
+        status = tfm_crypto_asymmetric_encrypt_interface(in_vec, out_vec,
+                                                         &encoded_key);
+        break;
     case TFM_CRYPTO_GROUP_ID_KEY_DERIVATION:
-        return tfm_crypto_key_derivation_interface(in_vec, out_vec,
-                                                   &encoded_key);
+        status = tfm_crypto_key_derivation_interface(in_vec, out_vec,
+                                                     &encoded_key);
+        break;
     case TFM_CRYPTO_GROUP_ID_RANDOM:
-        return tfm_crypto_random_interface(in_vec, out_vec);
+        status = tfm_crypto_random_interface(in_vec, out_vec);
+        break;
+#if CRYPTO_BATCH_MODULE_ENABLED
+    case TFM_CRYPTO_GROUP_ID_BATCH:
+        status = tfm_crypto_batch_interface(in_vec, in_len, out_vec, out_len);
+        break;
+#endif /* CRYPTO_BATCH_MODULE_ENABLED */
     default:
         LOG_ERRFMT("[ERR][Crypto] Unsupported request!\r\n");
         return PSA_ERROR_NOT_SUPPORTED;
     }
+
+#if CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0
+    if (is_key_required) {
+        tfm_crypto_key_residency_record(&encoded_key, iov->function_id, status);
+    }
+#endif /* CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0 */
+
+    return status;
 }
 
+#if CRYPTO_BATCH_MODULE_ENABLED
+/**
+ * \brief Runs the operations of a batch request in order, through the same
+ *        dispatcher used for single requests, stopping at the first one that
+ *        fails. The request stream is in in_vec[1] and the response stream in
+ *        out_vec[0], laid out as described by tfm_crypto_batch_entry and
+ *        tfm_crypto_batch_result. The headers are copied before being checked,
+ *        as the streams can be mapped client memory.
+ *
+ * \return The status of the last operation run, or an error if the batch
+ *         is malformed
+ */
+static psa_status_t tfm_crypto_batch_interface(psa_invec in_vec[],
+                                               size_t in_len,
+                                               psa_outvec out_vec[],
+                                               size_t out_len)
+{
+    const uint8_t *req;
+    uint8_t *rsp;
+    size_t req_len, rsp_size;
+    size_t req_off = 0, rsp_off = 0, i;
+    psa_status_t status = PSA_SUCCESS;
+
+    if ((in_len != 2) || (out_len != 1)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    req = in_vec[1].base;
+    req_len = in_vec[1].len;
+    rsp = out_vec[0].base;
+    rsp_size = out_vec[0].len;
+    out_vec[0].len = 0;
+
+    while ((req_off < req_len) && (status == PSA_SUCCESS)) {
+        struct tfm_crypto_batch_entry entry;
+        struct tfm_crypto_batch_result result;
+        psa_invec op_in_vec[PSA_MAX_IOVEC] = { {NULL, 0} };
+        psa_outvec op_out_vec[PSA_MAX_IOVEC] = { {NULL, 0} };
+        size_t rsp_data_off;
+
+        if (req_len - req_off < sizeof(entry)) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        memcpy(&entry, &req[req_off], sizeof(entry));
+        req_off += sizeof(entry);
+
+        if (entry.reserved != 0) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        if (((size_t)entry.in_count + entry.out_count > TFM_CRYPTO_BATCH_MAX_IOVEC) ||
+            (TFM_CRYPTO_GET_GROUP_ID(entry.iov.function_id) == TFM_CRYPTO_GROUP_ID_BATCH)) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+
+        op_in_vec[0].base = &entry.iov;
+        op_in_vec[0].len = sizeof(struct tfm_crypto_pack_iovec);
+        for (i = 0; i < entry.in_count; i++) {
+            if (entry.in_len[i] > req_len - req_off) {
+                return PSA_ERROR_PROGRAMMER_ERROR;
+            }
+            op_in_vec[i + 1].base = &req[req_off];
+            op_in_vec[i + 1].len = entry.in_len[i];
+            req_off += entry.in_len[i];
+            /* The padding after the last input of the batch can be omitted */
+            req_off = (TFM_CRYPTO_BATCH_ALIGN(req_off) < req_len) ?
+                      TFM_CRYPTO_BATCH_ALIGN(req_off) : req_len;
+        }
+
+        if (rsp_size - rsp_off < sizeof(result)) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        rsp_data_off = rsp_off + sizeof(result);
+        for (i = 0; i < entry.out_count; i++) {
+            if (entry.out_len[i] > rsp_size - rsp_data_off) {
+                return PSA_ERROR_PROGRAMMER_ERROR;
+            }
+            op_out_vec[i].base = &rsp[rsp_data_off];
+            op_out_vec[i].len = entry.out_len[i];
+            rsp_data_off += entry.out_len[i];
+            rsp_data_off = (TFM_CRYPTO_BATCH_ALIGN(rsp_data_off) < rsp_size) ?
+                           TFM_CRYPTO_BATCH_ALIGN(rsp_data_off) : rsp_size;
+        }
+
+        status = tfm_crypto_api_dispatcher(op_in_vec, entry.in_count + 1,
+                                           op_out_vec, entry.out_count);
+
+        memset(&result, 0, sizeof(result));
+        result.status = status;
+        for (i = 0; i < entry.out_count; i++) {
+            result.out_len[i] = op_out_vec[i].len;
+        }
+        memcpy(&rsp[rsp_off], &result, sizeof(result));
+
+        rsp_off = rsp_data_off;
+        out_vec[0].len = rsp_off;
+    }
+
+    return status;
+}
+#endif /* CRYPTO_BATCH_MODULE_ENABLED */
+
 static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
 {
     psa_status_t status = PSA_SUCCESS;
@@ -367,7 +509,40 @@ static psa_status_t tfm_crypto_engine_init(void)
      * the function below will perform also the same operations done by the HAL init
      * crypto_hw_accelerator_init()
      */
-    return psa_crypto_init();
+    status = psa_crypto_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+#ifdef CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE
+    /* The builtin key loader can only derive the per-user subkeys once the
+     * PSA subsystem is available, so do it here rather than on first use
+     */
+    status = tfm_builtin_key_loader_prederive_subkeys();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif /* CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE */
+
+#if CRYPTO_RNG_MODULE_ENABLED && (CRYPTO_RNG_POOL_SIZE > 0)
+    /* Fill the random pool now so that the first requests are served from it */
+    status = tfm_crypto_random_pool_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif /* CRYPTO_RNG_MODULE_ENABLED && (CRYPTO_RNG_POOL_SIZE > 0) */
+
+#if CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0
+    /* Load the persistent keys listed for prefetch, ITS is available as it
+     * is a dependency of this partition
+     */
+    status = tfm_crypto_key_residency_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif /* CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0 */
+
+    return PSA_SUCCESS;
 }
 
 static psa_status_t tfm_crypto_module_init(void)
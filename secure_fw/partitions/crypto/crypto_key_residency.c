@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "config_tfm.h"
+#include "tfm_mbedcrypto_include.h"
+
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+#include "crypto_library.h"
+
+#if CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0
+
+/*
+ * The PSA core keeps a persistent key in its slot table after using it, until
+ * it runs out of free slots and has to reuse the slot of whichever unused
+ * persistent key it finds first. Reloading that key later costs an ITS read
+ * and decryption. To avoid this, free slots are kept available ahead of each
+ * request by purging the least frequently used persistent keys first, so that
+ * the frequently used ones stay loaded.
+ *
+ * Residency is tracked from the requests seen here, as the PSA core doesn't
+ * report which keys it holds. When every slot is taken by pinned keys or keys
+ * in use, the PSA core still evicts a key on its own and the entry of that key
+ * stays marked as resident until it is purged, closed or picked as a victim.
+ * The hit and miss counts are therefore approximate in that case.
+ */
+
+/*!
+ * \brief Tracking information of a persistent key
+ */
+struct key_residency_entry_t {
+    struct tfm_crypto_key_id_s key; /*!< Owner and ID of the key */
+    uint16_t uses;                  /*!< Access count, halved periodically */
+    bool is_valid;                  /*!< Whether the entry tracks a key */
+    bool is_resident;               /*!< Whether the key is in a PSA core slot */
+    bool is_pinned;                 /*!< Whether the key must never be purged */
+};
+
+static struct key_residency_entry_t g_residency[CRYPTO_KEY_RESIDENCY_TRACKED_KEYS];
+static struct tfm_crypto_key_residency_stats_t g_residency_stats;
+
+#ifdef CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS
+static const struct tfm_crypto_key_id_s g_residency_prefetch[] =
+    CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS;
+#endif /* CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS */
+
+static bool key_residency_is_managed(const struct tfm_crypto_key_id_s *key)
+{
+    /* Volatile keys can't be reloaded and builtin keys are handled by their
+     * drivers, so only keys in the user persistent range are managed
+     */
+    return (key->key_id >= PSA_KEY_ID_USER_MIN) && (key->key_id <= PSA_KEY_ID_USER_MAX);
+}
+
+static struct key_residency_entry_t *key_residency_find(const struct tfm_crypto_key_id_s *key)
+{
+    for (size_t idx = 0; idx < CRYPTO_KEY_RESIDENCY_TRACKED_KEYS; idx++) {
+        if (g_residency[idx].is_valid &&
+            (g_residency[idx].key.key_id == key->key_id) &&
+            (g_residency[idx].key.owner == key->owner)) {
+            return &g_residency[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static struct key_residency_entry_t *key_residency_insert(const struct tfm_crypto_key_id_s *key)
+{
+    struct key_residency_entry_t *victim = NULL;
+
+    /* Reuse a free entry, or stop tracking the least used unpinned key. A key
+     * that stops being tracked is left in its slot for the PSA core to manage.
+     */
+    for (size_t idx = 0; idx < CRYPTO_KEY_RESIDENCY_TRACKED_KEYS; idx++) {
+        if (!g_residency[idx].is_valid) {
+            victim = &g_residency[idx];
+            break;
+        }
+        if (!g_residency[idx].is_pinned &&
+            ((victim == NULL) || (g_residency[idx].uses < victim->uses))) {
+            victim = &g_residency[idx];
+        }
+    }
+
+    if (victim != NULL) {
+        memset(victim, 0, sizeof(*victim));
+        victim->key = *key;
+        victim->is_valid = true;
+    }
+
+    return victim;
+}
+
+static void key_residency_count_use(struct key_residency_entry_t *entry)
+{
+    if (entry->uses == UINT16_MAX) {
+        /* Age all the counts so that keys which stopped being used can
+         * eventually become candidates for purging again
+         */
+        for (size_t idx = 0; idx < CRYPTO_KEY_RESIDENCY_TRACKED_KEYS; idx++) {
+            g_residency[idx].uses >>= 1;
+        }
+    }
+    entry->uses++;
+}
+
+static psa_status_t key_residency_load(const struct tfm_crypto_key_id_s *key)
+{
+    psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+    psa_status_t status;
+
+    /* Reading the attributes of a persistent key loads it into a slot */
+    status = psa_get_key_attributes(tfm_crypto_library_key_id_init(key->owner, key->key_id),
+                                    &attr);
+    psa_reset_key_attributes(&attr);
+
+    return status;
+}
+
+void tfm_crypto_key_residency_prepare(const struct tfm_crypto_key_id_s *key,
+                                      uint16_t function_id)
+{
+    mbedtls_psa_stats_t stats;
+    size_t empty_slots;
+
+    /* Only requests which can load or create a key need a free slot */
+    if (!key_residency_is_managed(key) &&
+        (function_id != TFM_CRYPTO_IMPORT_KEY_SID) &&
+        (function_id != TFM_CRYPTO_GENERATE_KEY_SID) &&
+        (function_id != TFM_CRYPTO_COPY_KEY_SID)) {
+        return;
+    }
+
+    mbedtls_psa_get_stats(&stats);
+    empty_slots = stats.MBEDTLS_PRIVATE(empty_slots);
+
+    while (empty_slots < CRYPTO_KEY_RESIDENCY_FREE_SLOTS) {
+        struct key_residency_entry_t *coldest = NULL;
+
+        for (size_t idx = 0; idx < CRYPTO_KEY_RESIDENCY_TRACKED_KEYS; idx++) {
+            /* The key used by this request is never the victim, purging it
+             * would only force the request to reload it
+             */
+            if (g_residency[idx].is_valid && g_residency[idx].is_resident &&
+                !g_residency[idx].is_pinned &&
+                ((g_residency[idx].key.key_id != key->key_id) ||
+                 (g_residency[idx].key.owner != key->owner)) &&
+                ((coldest == NULL) || (g_residency[idx].uses < coldest->uses))) {
+                coldest = &g_residency[idx];
+            }
+        }
+
+        if (coldest == NULL) {
+            /* Nothing left that can be purged, the PSA core picks its own */
+            break;
+        }
+
+        /* A key in use by a multipart operation stays in its slot, so the
+         * number of free slots is read back rather than assumed
+         */
+        coldest->is_resident = false;
+        (void)psa_purge_key(tfm_crypto_library_key_id_init(coldest->key.owner,
+                                                           coldest->key.key_id));
+        mbedtls_psa_get_stats(&stats);
+        if (stats.MBEDTLS_PRIVATE(empty_slots) > empty_slots) {
+            g_residency_stats.evictions++;
+        }
+        empty_slots = stats.MBEDTLS_PRIVATE(empty_slots);
+    }
+}
+
+void tfm_crypto_key_residency_record(const struct tfm_crypto_key_id_s *key,
+                                     uint16_t function_id,
+                                     psa_status_t status)
+{
+    struct key_residency_entry_t *entry;
+
+    if (!key_residency_is_managed(key)) {
+        return;
+    }
+
+    entry = key_residency_find(key);
+
+    switch (function_id) {
+    case TFM_CRYPTO_DESTROY_KEY_SID:
+        if (entry != NULL) {
+            memset(entry, 0, sizeof(*entry));
+        }
+        return;
+    case TFM_CRYPTO_CLOSE_KEY_SID:
+    case TFM_CRYPTO_PURGE_KEY_SID:
+        if (entry != NULL) {
+            entry->is_resident = false;
+        }
+        return;
+    default:
+        break;
+    }
+
+    if ((status == PSA_ERROR_DOES_NOT_EXIST) || (status == PSA_ERROR_INVALID_HANDLE)) {
+        if ((entry != NULL) && !entry->is_pinned) {
+            memset(entry, 0, sizeof(*entry));
+        }
+        return;
+    }
+
+    if ((entry != NULL) && entry->is_resident) {
+        g_residency_stats.hits++;
+    } else {
+        g_residency_stats.misses++;
+        if (entry == NULL) {
+            entry = key_residency_insert(key);
+            if (entry == NULL) {
+                return;
+            }
+        }
+    }
+
+    entry->is_resident = true;
+    key_residency_count_use(entry);
+}
+
+psa_status_t tfm_crypto_key_residency_init(void)
+{
+#ifdef CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS
+    struct key_residency_entry_t *entry;
+
+    for (size_t idx = 0; idx < sizeof(g_residency_prefetch) / sizeof(g_residency_prefetch[0]);
+         idx++) {
+        if (!key_residency_is_managed(&g_residency_prefetch[idx])) {
+            continue;
+        }
+
+        entry = key_residency_insert(&g_residency_prefetch[idx]);
+        if (entry == NULL) {
+            /* Every entry is already pinned */
+            break;
+        }
+        entry->is_pinned = true;
+
+        /* A listed key which hasn't been provisioned yet is loaded on its
+         * first use instead
+         */
+        tfm_crypto_key_residency_prepare(&g_residency_prefetch[idx], 0);
+        entry->is_resident = (key_residency_load(&g_residency_prefetch[idx]) == PSA_SUCCESS);
+    }
+#endif /* CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS */
+
+    return PSA_SUCCESS;
+}
+
+void tfm_crypto_key_residency_get_stats(struct tfm_crypto_key_residency_stats_t *stats)
+{
+    *stats = g_residency_stats;
+}
+#endif /* CRYPTO_KEY_RESIDENCY_TRACKED_KEYS > 0 */
@@ -5,6 +5,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
@@ -15,6 +16,7 @@
 #include "psa/crypto.h"
 #include "psa/error.h"
 #include "crypto_library.h"
+#include "tfm_crypto_defs.h"
 
 /**
  * \brief This include is required to get the underlying platform function
@@ -59,6 +61,22 @@ static char mbedtls_version_full[18];
 #include "config_engine_buf.h"
 static uint8_t mbedtls_mem_buf[CRYPTO_ENGINE_BUF_SIZE] = {0};
 
+/**
+ * \brief Index of the platform builtin key descriptor table
+ */
+static struct tfm_crypto_library_builtin_key_index_t g_builtin_key_desc_index;
+
+static psa_key_id_t builtin_key_table_get_key_id(const void *table, size_t entry_size,
+                                                 size_t key_id_offset, size_t idx)
+{
+    psa_key_id_t key_id;
+
+    memcpy(&key_id, (const uint8_t *)table + idx * entry_size + key_id_offset,
+           sizeof(key_id));
+
+    return key_id;
+}
+
 /* Make sure the library won't print anything through mbedtls_printf */
 static int null_printf(const char *fmt, ...)
 {
@@ -84,6 +102,60 @@ char *tfm_crypto_library_get_info(void)
     return mbedtls_version_full;
 }
 
+size_t tfm_crypto_library_builtin_key_index_find(
+    struct tfm_crypto_library_builtin_key_index_t *index,
+    const void *table, size_t number_of_keys, size_t entry_size,
+    size_t key_id_offset, psa_key_id_t key_id)
+{
+    psa_key_id_t id;
+    uint8_t entry;
+
+    if (!index->is_built) {
+        for (size_t idx = 0; idx < number_of_keys && idx < UINT8_MAX; idx++) {
+            id = builtin_key_table_get_key_id(table, entry_size, key_id_offset, idx);
+
+            /* Keys outside of the range are found by the fallback scan. Only
+             * the first entry of a key ID is indexed, as for the scan.
+             */
+            if (id >= TFM_BUILTIN_KEY_ID_MIN && id <= TFM_BUILTIN_KEY_ID_MAX &&
+                index->pos[id - TFM_BUILTIN_KEY_ID_MIN] == 0) {
+                index->pos[id - TFM_BUILTIN_KEY_ID_MIN] = (uint8_t)(idx + 1);
+            }
+        }
+        index->is_built = true;
+    }
+
+    if (key_id >= TFM_BUILTIN_KEY_ID_MIN && key_id <= TFM_BUILTIN_KEY_ID_MAX
+        && number_of_keys < UINT8_MAX) {
+        entry = index->pos[key_id - TFM_BUILTIN_KEY_ID_MIN];
+        return (entry != 0) ? (size_t)(entry - 1) : number_of_keys;
+    }
+
+    for (size_t idx = 0; idx < number_of_keys; idx++) {
+        if (builtin_key_table_get_key_id(table, entry_size, key_id_offset, idx) == key_id) {
+            return idx;
+        }
+    }
+
+    return number_of_keys;
+}
+
+const tfm_plat_builtin_key_descriptor_t *tfm_crypto_library_get_builtin_key_desc(
+    psa_key_id_t key_id)
+{
+    const tfm_plat_builtin_key_descriptor_t *desc_table = NULL;
+    size_t number_of_keys = tfm_plat_builtin_key_get_desc_table_ptr(&desc_table);
+    size_t idx;
+
+    idx = tfm_crypto_library_builtin_key_index_find(&g_builtin_key_desc_index,
+                                                    desc_table, number_of_keys,
+                                                    sizeof(desc_table[0]),
+                                                    offsetof(tfm_plat_builtin_key_descriptor_t, key_id),
+                                                    key_id);
+
+    return (idx < number_of_keys) ? &desc_table[idx] : NULL;
+}
+
 psa_status_t tfm_crypto_core_library_init(void)
 {
     /* Initialise the Mbed Crypto memory allocator to use static memory
@@ -119,17 +191,15 @@ psa_status_t mbedtls_psa_platform_get_builtin_key(
     psa_key_lifetime_t *lifetime,
     psa_drv_slot_number_t *slot_number)
 {
-    const tfm_plat_builtin_key_descriptor_t *desc_table = NULL;
-    size_t number_of_keys = tfm_plat_builtin_key_get_desc_table_ptr(&desc_table);
+    const tfm_plat_builtin_key_descriptor_t *desc =
+        tfm_crypto_library_get_builtin_key_desc(MBEDTLS_SVC_KEY_ID_GET_KEY_ID(key_id));
 
-    for (size_t idx = 0; idx < number_of_keys; idx++) {
-        if (desc_table[idx].key_id == MBEDTLS_SVC_KEY_ID_GET_KEY_ID(key_id)) {
-            *lifetime = desc_table[idx].lifetime;
-            *slot_number = desc_table[idx].slot_number;
-            return PSA_SUCCESS;
-        }
+    if (desc == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
     }
 
-    return PSA_ERROR_DOES_NOT_EXIST;
+    *lifetime = desc->lifetime;
+    *slot_number = desc->slot_number;
+    return PSA_SUCCESS;
 }
 /*!@}*/
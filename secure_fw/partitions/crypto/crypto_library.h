@@ -22,7 +22,13 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "psa/crypto.h"
+#include "tfm_plat_crypto_keys.h"
+#include "tfm_crypto_defs.h"
 
 /**
  * @brief Some integration might decide to enforce the same ABI on client and
@@ -74,6 +80,49 @@ tfm_crypto_library_key_id_t tfm_crypto_library_key_id_init(int32_t owner, psa_ke
  */
 char *tfm_crypto_library_get_info(void);
 
+/**
+ * @brief Index into a platform builtin key table, addressed by
+ *        (key_id - TFM_BUILTIN_KEY_ID_MIN). Each entry holds the position of the
+ *        first table entry of the key ID plus one, or zero if the table has no
+ *        entry for it. Built on first use, as the platform tables are constant
+ */
+struct tfm_crypto_library_builtin_key_index_t {
+    uint8_t pos[TFM_BUILTIN_KEY_ID_MAX - TFM_BUILTIN_KEY_ID_MIN + 1];
+    bool is_built;
+};
+
+/**
+ * @brief Looks up a key ID in a platform builtin key table. Key IDs in the
+ *        TF-M builtin key range are resolved through \p index, which is built
+ *        on the first call, other key IDs are found by scanning the table
+ *
+ * @param[in,out] index           Index of the table, zero-initialised
+ * @param[in]     table           Pointer to the first entry of the table
+ * @param[in]     number_of_keys  Number of entries in the table
+ * @param[in]     entry_size      Size in bytes of an entry of the table
+ * @param[in]     key_id_offset   Offset of the \ref psa_key_id_t key ID in an entry
+ * @param[in]     key_id          key ID to look up, without owner
+ *
+ * @return Position of the first entry of the key ID in the table, or
+ *         \p number_of_keys if the table has no entry for it
+ */
+size_t tfm_crypto_library_builtin_key_index_find(
+    struct tfm_crypto_library_builtin_key_index_t *index,
+    const void *table, size_t number_of_keys, size_t entry_size,
+    size_t key_id_offset, psa_key_id_t key_id);
+
+/**
+ * @brief Looks up the platform descriptor of a builtin key. Key IDs in the TF-M
+ *        builtin key range are resolved through an index built on first use
+ *
+ * @param[in] key_id  key ID of the builtin key, without owner
+ *
+ * @return Pointer to the descriptor in the platform table, or NULL if the
+ *         platform does not describe the key
+ */
+const tfm_plat_builtin_key_descriptor_t *tfm_crypto_library_get_builtin_key_desc(
+    psa_key_id_t key_id);
+
 /**
  * @brief This function initialises a \ref tfm_crypto_library_key_id_t with default values
  *
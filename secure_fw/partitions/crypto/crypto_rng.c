@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
  * Copyright (c) 2021, Nordic Semiconductor ASA.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -15,6 +15,85 @@
 #include "tfm_crypto_api.h"
 #include "tfm_crypto_defs.h"
 
+#if CRYPTO_RNG_MODULE_ENABLED && (CRYPTO_RNG_POOL_SIZE > 0)
+#include <string.h>
+
+/* Requests up to this size are served from the pool, larger ones are passed
+ * straight to the RNG as they would drain it anyway.
+ */
+#define CRYPTO_RNG_POOL_MAX_REQUEST (CRYPTO_RNG_POOL_SIZE / 4)
+
+/*
+ * Random bytes generated ahead of the requests that consume them. Bytes are
+ * taken from the end of the pool, and g_rng_pool_avail is the number of bytes
+ * that haven't been handed out yet.
+ */
+static uint8_t g_rng_pool[CRYPTO_RNG_POOL_SIZE];
+static size_t g_rng_pool_avail;
+
+static void rng_pool_erase(uint8_t *buf, size_t len)
+{
+    /* Volatile so that the compiler can't elide the writes */
+    volatile uint8_t *p = buf;
+
+    while (len-- > 0) {
+        *p++ = 0;
+    }
+}
+
+static psa_status_t rng_pool_refill(void)
+{
+    psa_status_t status;
+
+    /* Consumed bytes are already erased, so only the unused ones at the start
+     * of the pool need to be, in case the refill fails
+     */
+    rng_pool_erase(g_rng_pool, g_rng_pool_avail);
+    g_rng_pool_avail = 0;
+
+    status = psa_generate_random(g_rng_pool, sizeof(g_rng_pool));
+    if (status != PSA_SUCCESS) {
+        rng_pool_erase(g_rng_pool, sizeof(g_rng_pool));
+        return status;
+    }
+
+    g_rng_pool_avail = sizeof(g_rng_pool);
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t rng_pool_get_random(uint8_t *output, size_t output_size)
+{
+    psa_status_t status;
+    uint8_t *pool_output;
+
+    if (output_size > g_rng_pool_avail) {
+        status = rng_pool_refill();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    g_rng_pool_avail -= output_size;
+    pool_output = &g_rng_pool[g_rng_pool_avail];
+
+    (void)memcpy(output, pool_output, output_size);
+
+    /* The bytes are erased as soon as they are consumed, so that a later
+     * compromise of the partition memory can't reveal output already given
+     * out
+     */
+    rng_pool_erase(pool_output, output_size);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_crypto_random_pool_init(void)
+{
+    return rng_pool_refill();
+}
+#endif /* CRYPTO_RNG_MODULE_ENABLED && (CRYPTO_RNG_POOL_SIZE > 0) */
+
 /*!
  * \addtogroup tfm_crypto_api_shim_layer
  *
@@ -33,6 +112,12 @@ psa_status_t tfm_crypto_random_interface(psa_invec in_vec[],
     uint8_t *output = out_vec[0].base;
     size_t output_size = out_vec[0].len;
 
+#if CRYPTO_RNG_POOL_SIZE > 0
+    if (output_size <= CRYPTO_RNG_POOL_MAX_REQUEST) {
+        return rng_pool_get_random(output, output_size);
+    }
+#endif /* CRYPTO_RNG_POOL_SIZE > 0 */
+
     return psa_generate_random(output, output_size);
 #endif
 }
@@ -5,11 +5,13 @@
  *
  */
 #include <string.h>
+#include "config_tfm.h"
 #include "tfm_builtin_key_loader.h"
 #include "tfm_mbedcrypto_include.h"
 #include "psa_manifest/pid.h"
 #include "tfm_plat_crypto_keys.h"
 #include "crypto_library.h"
+#include "tfm_crypto_defs.h"
 
 #ifndef TFM_BUILTIN_MAX_KEY_LEN
 #define TFM_BUILTIN_MAX_KEY_LEN (48)
@@ -21,6 +23,19 @@
 
 #define NUMBER_OF_ELEMENTS_OF(x) (sizeof(x)/sizeof(*(x)))
 
+#if TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0
+/*!
+ * \brief A structure which describes a per-user subkey derived from a builtin key
+ */
+struct tfm_builtin_derived_subkey_t {
+    uint8_t __attribute__((aligned(4))) key[TFM_BUILTIN_MAX_KEY_LEN]; /*!< Derived key material, 4-byte aligned */
+    size_t key_len;                       /*!< Size of the derived key material */
+    int32_t user;                         /*!< The user that the subkey was derived for */
+    uint32_t last_used;                   /*!< Value of the use counter when last returned */
+    uint32_t is_valid;                    /*!< Boolean indicating whether the entry holds a subkey */
+};
+#endif /* TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0 */
+
 /*!
  * \brief A structure which describes a builtin key slot
  */
@@ -29,6 +44,9 @@ struct tfm_builtin_key_t {
     size_t key_len;                       /*!< Size of the key material held in the key buffer */
     psa_key_attributes_t attr;            /*!< Key attributes associated to the key */
     uint32_t is_loaded;                   /*!< Boolean indicating whether the slot is being used */
+#if TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0
+    struct tfm_builtin_derived_subkey_t subkeys[TFM_BUILTIN_MAX_DERIVED_SUBKEYS]; /*!< Cache of derived subkeys */
+#endif /* TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0 */
 };
 
 /*!
@@ -37,32 +55,55 @@ struct tfm_builtin_key_t {
  */
 static struct tfm_builtin_key_t g_builtin_key_slots[TFM_BUILTIN_MAX_KEYS] = {0};
 
+/*!
+ * \brief Index of the platform builtin key policy table
+ */
+static struct tfm_crypto_library_builtin_key_index_t g_builtin_key_policy_index;
+
+#if TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0
+/*!
+ * \brief Incremented each time a derived subkey is returned, to find the least
+ *        recently used subkey of a slot when one needs to be evicted
+ */
+static uint32_t g_subkey_use_counter;
+#endif /* TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0 */
+
 /*!
  * \brief This functions returns the slot associated to a key id interrogating the
  *        platform HAL table
  */
 static psa_status_t builtin_key_get_slot(psa_key_id_t key_id, psa_drv_slot_number_t *slot_ptr)
 {
-    const tfm_plat_builtin_key_descriptor_t *desc_table = NULL;
-    size_t number_of_keys = tfm_plat_builtin_key_get_desc_table_ptr(&desc_table);
-    psa_drv_slot_number_t slot_number = TFM_BUILTIN_KEY_SLOT_MAX;
-
-    for (size_t idx = 0; idx < number_of_keys; idx++) {
-        if (desc_table[idx].key_id == key_id) {
-            slot_number = desc_table[idx].slot_number;
-            break;
-        }
-    }
+    const tfm_plat_builtin_key_descriptor_t *desc = tfm_crypto_library_get_builtin_key_desc(key_id);
 
-    if (slot_number == TFM_BUILTIN_KEY_SLOT_MAX) {
+    if (desc == NULL) {
         *slot_ptr = TFM_BUILTIN_KEY_SLOT_MAX;
         return PSA_ERROR_DOES_NOT_EXIST;
     }
 
-    *slot_ptr = slot_number;
+    *slot_ptr = desc->slot_number;
     return PSA_SUCCESS;
 }
 
+/*!
+ * \brief This functions returns the policy associated to a key id, using the
+ *        index into the platform policy table for key ids in the builtin range
+ */
+static const tfm_plat_builtin_key_policy_t *builtin_key_get_policy(psa_key_id_t key_id)
+{
+    const tfm_plat_builtin_key_policy_t *policy_table = NULL;
+    size_t number_of_keys = tfm_plat_builtin_key_get_policy_table_ptr(&policy_table);
+    size_t idx;
+
+    idx = tfm_crypto_library_builtin_key_index_find(&g_builtin_key_policy_index,
+                                                    policy_table, number_of_keys,
+                                                    sizeof(policy_table[0]),
+                                                    offsetof(tfm_plat_builtin_key_policy_t, key_id),
+                                                    key_id);
+
+    return (idx < number_of_keys) ? &policy_table[idx] : NULL;
+}
+
 /*!
  * \brief This functions returns the attributes of the key interrogating the
  *        platform HAL
@@ -73,26 +114,24 @@ static psa_status_t builtin_key_get_attributes(
     psa_key_usage_t usage = 0x0;
 
     /* Retrieve the usage policy based on the key_id and the user of the key */
-    const tfm_plat_builtin_key_policy_t *policy_table = NULL;
-    size_t number_of_keys = tfm_plat_builtin_key_get_policy_table_ptr(&policy_table);
-
-    for (size_t idx = 0; idx < number_of_keys; idx++) {
-        if (policy_table[idx].key_id == key_id) {
-            if (policy_table[idx].per_user_policy == 0) {
-                usage = policy_table[idx].usage;
-            } else {
-                /* The policy depedends also on the user of the key */
-                size_t num_users = policy_table[idx].per_user_policy;
-                const tfm_plat_builtin_key_per_user_policy_t *p_policy = policy_table[idx].policy_ptr;
-
-                for (size_t j = 0; j < num_users; j++) {
-                    if (p_policy[j].user == user) {
-                        usage = p_policy[j].usage;
-                        break;
-                    }
+    const tfm_plat_builtin_key_policy_t *policy = builtin_key_get_policy(key_id);
+
+    if (policy != NULL) {
+        if (policy->per_user_policy == 0) {
+            usage = policy->usage;
+        } else {
+            /* The policy depends also on the user of the key. The per-user
+             * lists are short and bounded by the platform, so they are scanned.
+             */
+            size_t num_users = policy->per_user_policy;
+            const tfm_plat_builtin_key_per_user_policy_t *p_policy = policy->policy_ptr;
+
+            for (size_t j = 0; j < num_users; j++) {
+                if (p_policy[j].user == user) {
+                    usage = p_policy[j].usage;
+                    break;
                 }
             }
-            break;
         }
     }
 
@@ -188,6 +227,67 @@ wrap_up:
     return status;
 }
 
+#if TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0
+static void zeroize_subkey(struct tfm_builtin_derived_subkey_t *subkey)
+{
+    /* Volatile so that the compiler can't elide the writes */
+    volatile uint8_t *p = subkey->key;
+
+    for (size_t idx = 0; idx < sizeof(subkey->key); idx++) {
+        p[idx] = 0;
+    }
+
+    subkey->key_len = 0;
+    subkey->is_valid = 0;
+}
+
+/*!
+ * \brief This function returns the subkey of a user from the cache of a slot,
+ *        deriving it into the cache first if it isn't already there. The least
+ *        recently used subkey of the slot is evicted if the cache is full.
+ */
+static psa_status_t get_cached_subkey(
+        struct tfm_builtin_key_t *key_slot, int32_t user, size_t key_len,
+        struct tfm_builtin_derived_subkey_t **subkey_ptr)
+{
+    struct tfm_builtin_derived_subkey_t *subkey = &key_slot->subkeys[0];
+    psa_status_t status;
+
+    for (size_t idx = 0; idx < TFM_BUILTIN_MAX_DERIVED_SUBKEYS; idx++) {
+        struct tfm_builtin_derived_subkey_t *entry = &key_slot->subkeys[idx];
+
+        if (entry->is_valid && entry->user == user && entry->key_len == key_len) {
+            subkey = entry;
+            goto found;
+        }
+
+        /* Keep track of the best candidate for eviction */
+        if (subkey->is_valid
+            && (!entry->is_valid || entry->last_used < subkey->last_used)) {
+            subkey = entry;
+        }
+    }
+
+    zeroize_subkey(subkey);
+
+    status = derive_subkey_into_buffer(key_slot, user, subkey->key, key_len,
+                                       &subkey->key_len);
+    if (status != PSA_SUCCESS) {
+        zeroize_subkey(subkey);
+        return status;
+    }
+
+    subkey->user = user;
+    subkey->is_valid = 1;
+
+found:
+    subkey->last_used = ++g_subkey_use_counter;
+    *subkey_ptr = subkey;
+
+    return PSA_SUCCESS;
+}
+#endif /* TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0 */
+
 /*!
  * \defgroup tfm_builtin_key_loader
  *
@@ -327,6 +427,22 @@ psa_status_t tfm_builtin_key_loader_get_builtin_key(
      */
     int32_t user = CRYPTO_LIBRARY_GET_OWNER(key_id);
     if (psa_get_key_usage_flags(attributes) & PSA_KEY_USAGE_DERIVE && user != TFM_SP_CRYPTO) {
+#if TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0
+        /* The derivation is a full import/derive/export round trip through
+         * the PSA core, so the result is cached for the next time the core
+         * loads the key for the same user.
+         */
+        struct tfm_builtin_derived_subkey_t *subkey;
+
+        if (key_buffer_size <= TFM_BUILTIN_MAX_KEY_LEN) {
+            err = get_cached_subkey(key_slot, user, key_buffer_size, &subkey);
+            if (err == PSA_SUCCESS) {
+                memcpy(key_buffer, subkey->key, subkey->key_len);
+                *key_buffer_length = subkey->key_len;
+            }
+            goto wrap_up;
+        }
+#endif /* TFM_BUILTIN_MAX_DERIVED_SUBKEYS > 0 */
 
         err = derive_subkey_into_buffer(key_slot, user,
                                         key_buffer, key_buffer_size,
@@ -339,4 +455,51 @@ psa_status_t tfm_builtin_key_loader_get_builtin_key(
 wrap_up:
     return err;
 }
+
+#ifdef CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE
+psa_status_t tfm_builtin_key_loader_prederive_subkeys(void)
+{
+    const tfm_plat_builtin_key_policy_t *policy_table = NULL;
+    size_t number_of_keys = tfm_plat_builtin_key_get_policy_table_ptr(&policy_table);
+    struct tfm_builtin_derived_subkey_t *subkey;
+    psa_drv_slot_number_t slot_number;
+    psa_status_t err;
+
+    for (size_t idx = 0; idx < number_of_keys; idx++) {
+        const tfm_plat_builtin_key_per_user_policy_t *p_policy;
+
+        /* Only keys with a per-user policy have a known set of users */
+        if (policy_table[idx].per_user_policy == 0) {
+            continue;
+        }
+        p_policy = policy_table[idx].policy_ptr;
+
+        err = builtin_key_get_slot(policy_table[idx].key_id, &slot_number);
+        if (err != PSA_SUCCESS || !g_builtin_key_slots[slot_number].is_loaded) {
+            /* The key is handled by a different driver */
+            continue;
+        }
+
+        for (size_t j = 0; j < policy_table[idx].per_user_policy; j++) {
+            if (!(p_policy[j].usage & PSA_KEY_USAGE_DERIVE)
+                || p_policy[j].user == TFM_SP_CRYPTO) {
+                continue;
+            }
+
+            /* The PSA core requests the key in a buffer of the size returned by
+             * tfm_builtin_key_loader_get_key_buffer_size()
+             */
+            err = get_cached_subkey(&g_builtin_key_slots[slot_number],
+                                    p_policy[j].user,
+                                    g_builtin_key_slots[slot_number].key_len,
+                                    &subkey);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE */
 /*!@}*/
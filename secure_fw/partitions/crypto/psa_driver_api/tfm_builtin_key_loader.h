@@ -95,6 +95,20 @@ psa_status_t tfm_builtin_key_loader_get_builtin_key(
         psa_drv_slot_number_t slot_number, psa_key_attributes_t *attributes,
         uint8_t *key_buffer, size_t key_buffer_size, size_t *key_buffer_length);
 
+#ifdef CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE
+/**
+ * \brief Derives the per-user subkeys of all the builtin keys that have a
+ *        per-user policy allowing derivation, so that they are already cached
+ *        when first used.
+ *
+ * \note This uses the PSA Crypto APIs, so it must be called after
+ *       psa_crypto_init() has completed, rather than from the driver init.
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t tfm_builtin_key_loader_prederive_subkeys(void);
+#endif /* CRYPTO_TFM_BUILTIN_KEYS_PREDERIVE */
+
 #ifdef __cplusplus
 }
 #endif
@@ -189,6 +189,69 @@ psa_status_t tfm_crypto_key_derivation_interface(psa_invec in_vec[],
  */
 psa_status_t tfm_crypto_random_interface(psa_invec in_vec[],
                                          psa_outvec out_vec[]);
+
+/**
+ * \brief Fills the pool used to serve small random requests, when
+ *        CRYPTO_RNG_POOL_SIZE is not 0. Must be called after the PSA Crypto
+ *        core has been initialised.
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_random_pool_init(void);
+
+/**
+ * \brief Statistics of the key slot residency manager
+ *
+ * \note Hits and misses are approximate: a key which the PSA core evicts on its
+ *       own, because no slot could be kept free, is still counted as a hit on
+ *       its next use.
+ */
+struct tfm_crypto_key_residency_stats_t {
+    uint32_t hits;      /*!< Uses of a persistent key that was already loaded */
+    uint32_t misses;    /*!< Uses of a persistent key that had to be loaded */
+    uint32_t evictions; /*!< Keys purged to keep slots free */
+};
+
+/**
+ * \brief Initialises the key slot residency manager, loading and pinning the
+ *        keys listed in CRYPTO_KEY_RESIDENCY_PREFETCH_KEYS. Must be called
+ *        after the PSA Crypto core has been initialised.
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_key_residency_init(void);
+
+/**
+ * \brief Purges the least frequently used persistent keys until at least
+ *        CRYPTO_KEY_RESIDENCY_FREE_SLOTS key slots are free. Called before a
+ *        request which uses a key, so that the PSA core doesn't have to evict
+ *        a key on its own. Does nothing for requests which can't load or
+ *        create a key.
+ *
+ * \param[in] key          Owner and ID of the key used by the request
+ * \param[in] function_id  Function ID of the request
+ */
+void tfm_crypto_key_residency_prepare(const struct tfm_crypto_key_id_s *key,
+                                      uint16_t function_id);
+
+/**
+ * \brief Records the use of a key by a request, once it has been handled
+ *
+ * \param[in] key          Owner and ID of the key used by the request
+ * \param[in] function_id  Function ID of the request
+ * \param[in] status       Status returned by the request
+ */
+void tfm_crypto_key_residency_record(const struct tfm_crypto_key_id_s *key,
+                                     uint16_t function_id,
+                                     psa_status_t status);
+
+/**
+ * \brief Retrieves the hit, miss and eviction counts of the key slot
+ *        residency manager
+ *
+ * \param[out] stats  Filled with the current statistics
+ */
+void tfm_crypto_key_residency_get_stats(struct tfm_crypto_key_residency_stats_t *stats);
 /**
  * \brief This function acts as interface for the Hash module
  *
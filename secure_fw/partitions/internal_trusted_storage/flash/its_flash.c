@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -20,15 +20,14 @@ uint8_t its_block_data[ITS_RAM_FS_SIZE];
 #ifndef ITS_FLASH_NAND_BUF_SIZE
 #error "ITS_FLASH_NAND_BUF_SIZE must be defined by the target in flash_layout.h"
 #endif
-static uint8_t its_write_buf_0[ITS_FLASH_NAND_BUF_SIZE];
-static uint8_t its_write_buf_1[ITS_FLASH_NAND_BUF_SIZE];
+static uint8_t its_cache_buf[ITS_FLASH_NAND_CACHE_BLOCKS][ITS_FLASH_NAND_BUF_SIZE];
+static struct its_flash_nand_cache_entry_t its_cache[ITS_FLASH_NAND_CACHE_BLOCKS];
 struct its_flash_nand_dev_t its_flash_nand_dev = {
     .driver = &TFM_HAL_ITS_FLASH_DRIVER,
-    .buf_block_id_0 = ITS_BLOCK_INVALID_ID,
-    .buf_block_id_1 = ITS_BLOCK_INVALID_ID,
-    .write_buf_0 = its_write_buf_0,
-    .write_buf_1 = its_write_buf_1,
-    .buf_size = sizeof(its_write_buf_0),
+    .cache = its_cache,
+    .cache_buf = &its_cache_buf[0][0],
+    .cache_entries = ITS_FLASH_NAND_CACHE_BLOCKS,
+    .buf_size = ITS_FLASH_NAND_BUF_SIZE,
 };
 #endif
 
@@ -43,15 +42,14 @@ uint8_t ps_block_data[PS_RAM_FS_SIZE];
 #ifndef PS_FLASH_NAND_BUF_SIZE
 #error "PS_FLASH_NAND_BUF_SIZE must be defined by the target in flash_layout.h"
 #endif
-static uint8_t ps_write_buf_0[PS_FLASH_NAND_BUF_SIZE];
-static uint8_t ps_write_buf_1[PS_FLASH_NAND_BUF_SIZE];
+static uint8_t ps_cache_buf[PS_FLASH_NAND_CACHE_BLOCKS][PS_FLASH_NAND_BUF_SIZE];
+static struct its_flash_nand_cache_entry_t ps_cache[PS_FLASH_NAND_CACHE_BLOCKS];
 struct its_flash_nand_dev_t ps_flash_nand_dev = {
     .driver = &TFM_HAL_PS_FLASH_DRIVER,
-    .buf_block_id_0 = ITS_BLOCK_INVALID_ID,
-    .buf_block_id_1 = ITS_BLOCK_INVALID_ID,
-    .write_buf_0 = ps_write_buf_0,
-    .write_buf_1 = ps_write_buf_1,
-    .buf_size = sizeof(ps_write_buf_0),
+    .cache = ps_cache,
+    .cache_buf = &ps_cache_buf[0][0],
+    .cache_entries = PS_FLASH_NAND_CACHE_BLOCKS,
+    .buf_size = PS_FLASH_NAND_BUF_SIZE,
 };
 #endif
 #endif /* TFM_PARTITION_PROTECTED_STORAGE */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -33,13 +33,227 @@ static uint32_t get_phys_address(const struct its_flash_fs_config_t *cfg,
     return cfg->flash_area_addr + (block_id * cfg->block_size) + offset;
 }
 
+/**
+ * \brief Gets the buffer of a cache entry.
+ *
+ * \param[in] flash_dev  NAND flash device
+ * \param[in] entry      Cache entry of the device
+ *
+ * \returns Returns the buffer holding the cached block.
+ */
+static uint8_t *cache_entry_buf(const struct its_flash_nand_dev_t *flash_dev,
+                                const struct its_flash_nand_cache_entry_t *entry)
+{
+    return flash_dev->cache_buf +
+           ((size_t)(entry - flash_dev->cache) * flash_dev->buf_size);
+}
+
+/**
+ * \brief Marks a cache entry as the most recently used one.
+ *
+ * \param[in,out] flash_dev  NAND flash device
+ * \param[in,out] entry      Cache entry of the device
+ */
+static void cache_entry_touch(struct its_flash_nand_dev_t *flash_dev,
+                              struct its_flash_nand_cache_entry_t *entry)
+{
+    entry->last_use = ++flash_dev->lru_clock;
+}
+
+/**
+ * \brief Looks up a block in the cache.
+ *
+ * \param[in] flash_dev  NAND flash device
+ * \param[in] block_id   Block ID
+ *
+ * \returns Returns the cache entry of the block, or NULL if it is not cached.
+ */
+static struct its_flash_nand_cache_entry_t *cache_find(
+                                    struct its_flash_nand_dev_t *flash_dev,
+                                    uint32_t block_id)
+{
+    size_t idx;
+
+    for (idx = 0; idx < flash_dev->cache_entries; idx++) {
+        if (flash_dev->cache[idx].is_valid &&
+            (flash_dev->cache[idx].block_id == block_id)) {
+            return &flash_dev->cache[idx];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Selects a cache entry to hold a new block. Unused entries are taken
+ *        first, then the least recently used clean entry. Dirty entries are
+ *        only released by a flush of their block.
+ *
+ * \param[in] flash_dev  NAND flash device
+ *
+ * \returns Returns the cache entry, or NULL if all the entries are dirty.
+ */
+static struct its_flash_nand_cache_entry_t *cache_get_victim(
+                                    struct its_flash_nand_dev_t *flash_dev)
+{
+    struct its_flash_nand_cache_entry_t *victim = NULL;
+    struct its_flash_nand_cache_entry_t *entry;
+    size_t idx;
+
+    for (idx = 0; idx < flash_dev->cache_entries; idx++) {
+        entry = &flash_dev->cache[idx];
+
+        if (!entry->is_valid) {
+            return entry;
+        }
+
+        /* The age is taken relative to the clock so that wrapping is safe */
+        if (!entry->is_dirty &&
+            ((victim == NULL) ||
+             ((uint32_t)(flash_dev->lru_clock - entry->last_use) >
+              (uint32_t)(flash_dev->lru_clock - victim->last_use)))) {
+            victim = entry;
+        }
+    }
+
+    return victim;
+}
+
+/**
+ * \brief Reads data from the flash device, handling a start address or a size
+ *        which is not aligned to the data width of the driver.
+ *
+ * \param[in]  flash_dev  NAND flash device
+ * \param[in]  addr       Physical address to read from
+ * \param[out] buff       Buffer to read the data into
+ * \param[in]  size       Size of the data to read
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE.
+ */
+static psa_status_t flash_read_data(const struct its_flash_nand_dev_t *flash_dev,
+                                    uint32_t addr, uint8_t *buff, size_t size)
+{
+    uint32_t remaining_len, read_length = 0;
+    uint32_t aligned_addr;
+    uint32_t item_number;
+
+    /* The max size of flash data_width is 4 bytes. */
+    uint8_t temp_buffer[sizeof(uint32_t)];
+    uint8_t data_width = flash_dev->data_width;
+    int ret;
+
+    remaining_len = size;
+
+    /*
+     * CMSIS ARM_FLASH_ReadData API requires the `addr` data type size
+     * aligned. Data type size is specified by the data_width in
+     * ARM_FLASH_CAPABILITIES.
+     */
+    aligned_addr = (addr / data_width) * data_width;
+
+    /* Read the first data_width bytes data if `addr` is not aligned. */
+    if (aligned_addr != addr) {
+        ret = flash_dev->driver->ReadData(aligned_addr, temp_buffer, 1);
+        if (ret < 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+
+        /* Record how many target data have been read. */
+        read_length = (((addr - aligned_addr + size) >= data_width) ?
+                            (data_width - (addr - aligned_addr)) : size);
+        /* Copy the read data. */
+        memcpy(buff, temp_buffer + addr - aligned_addr, read_length);
+        remaining_len -= read_length;
+    }
+
+    /*
+     * The `cnt` parameter in CMSIS ARM_FLASH_ReadData indicates number of
+     * data items to read.
+     */
+    if (remaining_len) {
+        item_number = remaining_len / data_width;
+        if (item_number) {
+            ret = flash_dev->driver->ReadData(addr + read_length,
+                                              (uint8_t *)buff + read_length,
+                                              item_number);
+            if (ret < 0) {
+                return PSA_ERROR_STORAGE_FAILURE;
+            }
+            read_length += item_number * data_width;
+            remaining_len -= item_number * data_width;
+        }
+    }
+
+    /* Read the last data item if there is still remaining data. */
+    if (remaining_len) {
+        ret = flash_dev->driver->ReadData(addr + read_length,
+                                          temp_buffer, 1);
+        if (ret < 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+        /* Copy the read data. */
+        memcpy(buff + read_length, temp_buffer, remaining_len);
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Extends the cached range of a clean cache entry to cover the given
+ *        range. The cached range stays contiguous, so only the part of the
+ *        block between the lowest and the highest offset read is loaded, and
+ *        each byte of it is read from the device once while it is cached.
+ *
+ * \param[in]     cfg        Flash FS configuration
+ * \param[in,out] flash_dev  NAND flash device
+ * \param[in,out] entry      Cache entry of the device
+ * \param[in]     offset     Offset of the range in the block
+ * \param[in]     size       Size of the range
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE.
+ */
+static psa_status_t cache_entry_fill(const struct its_flash_fs_config_t *cfg,
+                                     struct its_flash_nand_dev_t *flash_dev,
+                                     struct its_flash_nand_cache_entry_t *entry,
+                                     size_t offset, size_t size)
+{
+    uint8_t *buf = cache_entry_buf(flash_dev, entry);
+    size_t end = offset + size;
+    psa_status_t status;
+
+    if (offset < entry->valid_start) {
+        status = flash_read_data(flash_dev,
+                                 get_phys_address(cfg, entry->block_id, offset),
+                                 buf + offset, entry->valid_start - offset);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        entry->valid_start = offset;
+    }
+
+    if (end > entry->valid_end) {
+        status = flash_read_data(flash_dev,
+                                 get_phys_address(cfg, entry->block_id,
+                                                  entry->valid_end),
+                                 buf + entry->valid_end, end - entry->valid_end);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        entry->valid_end = end;
+    }
+
+    return PSA_SUCCESS;
+}
+
 static psa_status_t its_flash_nand_init(const struct its_flash_fs_config_t *cfg)
 {
     int32_t err;
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    ARM_FLASH_CAPABILITIES DriverCapabilities;
 
-    if (flash_dev->buf_size < cfg->block_size) {
+    if ((flash_dev->buf_size < cfg->block_size) ||
+        (flash_dev->cache_entries < 2)) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
@@ -48,6 +262,16 @@ static psa_status_t its_flash_nand_init(const struct its_flash_fs_config_t *cfg)
         return PSA_ERROR_STORAGE_FAILURE;
     }
 
+    /* The capabilities of the driver don't change, so they are read once
+     * rather than on each read and flush.
+     */
+    DriverCapabilities = flash_dev->driver->GetCapabilities();
+    if (DriverCapabilities.data_width >=
+        (sizeof(data_width_byte) / sizeof(data_width_byte[0]))) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+    flash_dev->data_width = data_width_byte[DriverCapabilities.data_width];
+
     return PSA_SUCCESS;
 }
 
@@ -57,83 +281,44 @@ static psa_status_t its_flash_nand_read(const struct its_flash_fs_config_t *cfg,
 {
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
-    uint32_t addr;
-    uint32_t remaining_len, read_length = 0;
-    uint32_t aligned_addr;
-    uint32_t item_number;
-
-    /* The max size of flash data_width is 4 bytes. */
-    uint8_t temp_buffer[sizeof(uint32_t)];
-    ARM_FLASH_CAPABILITIES DriverCapabilities;
-    uint8_t data_width;
-    int ret;
+    struct its_flash_nand_cache_entry_t *entry;
+    psa_status_t status;
 
     if (block_id == ITS_BLOCK_INVALID_ID) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    if (block_id == flash_dev->buf_block_id_0) {
-        (void)memcpy(buff, flash_dev->write_buf_0 + offset, size);
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        (void)memcpy(buff, flash_dev->write_buf_1 + offset, size);
-    } else {
-        addr = get_phys_address(cfg, block_id, offset);
-        remaining_len = size;
-        DriverCapabilities = flash_dev->driver->GetCapabilities();
-        data_width = data_width_byte[DriverCapabilities.data_width];
-
-        /*
-         * CMSIS ARM_FLASH_ReadData API requires the `addr` data type size
-         * aligned. Data type size is specified by the data_width in
-         * ARM_FLASH_CAPABILITIES.
-         */
-        aligned_addr = (addr / data_width) * data_width;
-
-        /* Read the first data_width bytes data if `addr` is not aligned. */
-        if (aligned_addr != addr) {
-            ret = flash_dev->driver->ReadData(aligned_addr, temp_buffer, 1);
-            if (ret < 0) {
-                return PSA_ERROR_STORAGE_FAILURE;
-            }
-
-            /* Record how many target data have been read. */
-            read_length = (((addr - aligned_addr + size) >= data_width) ?
-                                (data_width - (addr - aligned_addr)) : size);
-            /* Copy the read data. */
-            memcpy(buff, temp_buffer + addr - aligned_addr, read_length);
-            remaining_len -= read_length;
+    entry = cache_find(flash_dev, block_id);
+    if (entry == NULL) {
+        entry = cache_get_victim(flash_dev);
+        if (entry == NULL) {
+            /* All the entries hold pending writes, read around the cache */
+            return flash_read_data(flash_dev,
+                                   get_phys_address(cfg, block_id, offset),
+                                   buff, size);
         }
 
-        /*
-         * The `cnt` parameter in CMSIS ARM_FLASH_ReadData indicates number of
-         * data items to read.
+        /* Only the requested range is loaded, the cached range grows with
+         * the next reads of the block.
          */
-        if (remaining_len) {
-            item_number = remaining_len / data_width;
-            if (item_number) {
-                ret = flash_dev->driver->ReadData(addr + read_length,
-                                                  (uint8_t *)buff + read_length,
-                                                  item_number);
-                if (ret < 0) {
-                    return PSA_ERROR_STORAGE_FAILURE;
-                }
-                read_length += item_number * data_width;
-                remaining_len -= item_number * data_width;
-            }
-        }
+        entry->block_id = block_id;
+        entry->valid_start = offset;
+        entry->valid_end = offset;
+        entry->is_valid = true;
+        entry->is_dirty = false;
+    }
 
-        /* Read the last data item if there is still remaining data. */
-        if (remaining_len) {
-            ret = flash_dev->driver->ReadData(addr + read_length,
-                                              temp_buffer, 1);
-            if (ret < 0) {
-                return PSA_ERROR_STORAGE_FAILURE;
-            }
-            /* Copy the read data. */
-            memcpy(buff + read_length, temp_buffer, remaining_len);
+    if ((offset < entry->valid_start) || (offset + size > entry->valid_end)) {
+        status = cache_entry_fill(cfg, flash_dev, entry, offset, size);
+        if (status != PSA_SUCCESS) {
+            entry->is_valid = false;
+            return status;
         }
     }
 
+    (void)memcpy(buff, cache_entry_buf(flash_dev, entry) + offset, size);
+    cache_entry_touch(flash_dev, entry);
+
     return PSA_SUCCESS;
 }
 
@@ -144,28 +329,39 @@ static psa_status_t its_flash_nand_write(
 {
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    struct its_flash_nand_cache_entry_t *entry;
 
     if (block_id == ITS_BLOCK_INVALID_ID) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    /* Write to the match block buffer if exists. Otherwise use the empty
-     * buffer if exists. If no more empty buffer, return error.
+    /* Write to the matching dirty entry if it exists. Otherwise start a new
+     * write buffer in the entry of the block, or in a clean entry. If all
+     * entries are dirty, return error.
      */
-    if (block_id == flash_dev->buf_block_id_0) {
-        (void)memcpy(flash_dev->write_buf_0 + offset, buff, size);
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        (void)memcpy(flash_dev->write_buf_1 + offset, buff, size);
-    } else if (flash_dev->buf_block_id_0 == ITS_BLOCK_INVALID_ID) {
-        flash_dev->buf_block_id_0 = block_id;
-        (void)memcpy(flash_dev->write_buf_0 + offset, buff, size);
-    } else if (flash_dev->buf_block_id_1 == ITS_BLOCK_INVALID_ID) {
-        flash_dev->buf_block_id_1 = block_id;
-        (void)memcpy(flash_dev->write_buf_1 + offset, buff, size);
-    } else {
-        return PSA_ERROR_PROGRAMMER_ERROR;
+    entry = cache_find(flash_dev, block_id);
+    if ((entry == NULL) || !entry->is_dirty) {
+        if (entry == NULL) {
+            entry = cache_get_victim(flash_dev);
+            if (entry == NULL) {
+                return PSA_ERROR_PROGRAMMER_ERROR;
+            }
+        }
+
+        /* The file system only writes to erased blocks, and the data it
+         * doesn't write is programmed as zero.
+         */
+        (void)memset(cache_entry_buf(flash_dev, entry), 0, flash_dev->buf_size);
+        entry->block_id = block_id;
+        entry->valid_start = 0;
+        entry->valid_end = cfg->block_size;
+        entry->is_valid = true;
+        entry->is_dirty = true;
     }
 
+    (void)memcpy(cache_entry_buf(flash_dev, entry) + offset, buff, size);
+    cache_entry_touch(flash_dev, entry);
+
     return PSA_SUCCESS;
 }
 
@@ -176,45 +372,29 @@ static psa_status_t its_flash_nand_flush(
     int32_t err;
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    struct its_flash_nand_cache_entry_t *entry;
     uint32_t addr;
-    ARM_FLASH_CAPABILITIES DriverCapabilities;
-    uint8_t data_width;
 
-    DriverCapabilities = flash_dev->driver->GetCapabilities();
-    data_width = data_width_byte[DriverCapabilities.data_width];
-    if (block_id == flash_dev->buf_block_id_0) {
-        addr = get_phys_address(cfg, flash_dev->buf_block_id_0, 0);
-
-        /*
-         * Flush the buffered write data to flash. For NAND flash,
-         * cfg->block_size should always be a multiplier of data_width.
-         */
-        err = flash_dev->driver->ProgramData(addr, flash_dev->write_buf_0,
-                                             cfg->block_size / data_width);
-        if (err < 0) {
-            return PSA_ERROR_STORAGE_FAILURE;
-        }
+    entry = cache_find(flash_dev, block_id);
+    if ((entry == NULL) || !entry->is_dirty) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
 
-        /* Clear the write buffer */
-        (void)memset(flash_dev->write_buf_0, 0, flash_dev->buf_size);
-        flash_dev->buf_block_id_0 = ITS_BLOCK_INVALID_ID;
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        addr = get_phys_address(cfg, flash_dev->buf_block_id_1, 0);
+    addr = get_phys_address(cfg, block_id, 0);
 
-        /* Flush the buffered write data to flash*/
-        err = flash_dev->driver->ProgramData(addr, flash_dev->write_buf_1,
-                                             cfg->block_size / data_width);
-        if (err < 0) {
-            return PSA_ERROR_STORAGE_FAILURE;
-        }
-
-        /* Clear the write buffer */
-        (void)memset(flash_dev->write_buf_1, 0, flash_dev->buf_size);
-        flash_dev->buf_block_id_1 = ITS_BLOCK_INVALID_ID;
-    } else {
-        return PSA_ERROR_GENERIC_ERROR;
+    /*
+     * Flush the buffered write data to flash. For NAND flash,
+     * cfg->block_size should always be a multiplier of data_width.
+     */
+    err = flash_dev->driver->ProgramData(addr, cache_entry_buf(flash_dev, entry),
+                                         cfg->block_size / flash_dev->data_width);
+    if (err < 0) {
+        return PSA_ERROR_STORAGE_FAILURE;
     }
 
+    /* The buffer now matches the block in flash, keep it cached for reads */
+    entry->is_dirty = false;
+
     return PSA_SUCCESS;
 }
 
@@ -226,6 +406,15 @@ static psa_status_t its_flash_nand_erase(const struct its_flash_fs_config_t *cfg
     size_t offset;
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    struct its_flash_nand_cache_entry_t *entry;
+
+    /* Drop the cached content of the block. Pending writes are kept, to be
+     * programmed when the block is flushed.
+     */
+    entry = cache_find(flash_dev, block_id);
+    if ((entry != NULL) && !entry->is_dirty) {
+        entry->is_valid = false;
+    }
 
     for (offset = 0; offset < cfg->block_size; offset += cfg->sector_size) {
         addr = get_phys_address(cfg, block_id, offset);
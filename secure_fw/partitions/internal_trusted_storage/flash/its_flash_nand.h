@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,6 +15,7 @@
 #ifndef __ITS_FLASH_NAND_H__
 #define __ITS_FLASH_NAND_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -24,16 +25,32 @@
 extern "C" {
 #endif
 
+/**
+ * \brief Block cache entry of a NAND flash device
+ */
+struct its_flash_nand_cache_entry_t {
+    uint32_t block_id;    /*!< Cached block */
+    uint32_t last_use;    /*!< LRU clock value at the last access to the block */
+    uint32_t valid_start; /*!< Offset of the first cached byte of the block */
+    uint32_t valid_end;   /*!< Offset following the last cached byte */
+    bool is_valid;        /*!< Whether the entry caches a block */
+    bool is_dirty;        /*!< Whether the buffer holds data not yet programmed */
+};
+
 struct its_flash_nand_dev_t {
     ARM_DRIVER_FLASH *driver;
-    /* Two write buffers are reserved as the metadata block and the file block
-     * write can be mixed in the file system operation.
+    /* A block cache serves both reads and writes. Written blocks are kept in
+     * the cache until they are flushed, and at least two entries are
+     * required as the metadata block and the file block write can be mixed
+     * in the file system operation. The remaining entries, and the entries
+     * of flushed blocks, cache the blocks last read from flash.
      */
-    uint32_t buf_block_id_0;
-    uint32_t buf_block_id_1;
-    uint8_t *write_buf_0;
-    uint8_t *write_buf_1;
+    struct its_flash_nand_cache_entry_t *cache;
+    uint8_t *cache_buf;   /* cache_entries buffers of buf_size bytes each */
+    size_t cache_entries;
     size_t buf_size;
+    uint32_t lru_clock;   /* Incremented on each access to the cache */
+    uint8_t data_width;   /* Data item width of the driver, in bytes */
 };
 
 extern const struct its_flash_fs_ops_t its_flash_fs_ops_nand;
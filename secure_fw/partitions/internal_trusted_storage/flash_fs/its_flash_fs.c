@@ -195,6 +195,11 @@ psa_status_t its_flash_fs_wipe_all(struct its_flash_fs_ctx_t *fs_ctx)
     return its_flash_fs_mblock_reset_metablock(fs_ctx);
 }
 
+psa_status_t its_flash_fs_erase_scratch_blocks(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    return its_flash_fs_mblock_erase_scratch_blocks(fs_ctx);
+}
+
 psa_status_t its_flash_fs_file_get_info(struct its_flash_fs_ctx_t *fs_ctx,
                                         const uint8_t *fid,
                                         struct its_flash_fs_file_info_t *info)
@@ -250,6 +255,12 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
     finfo->size_max = ITS_UTILS_ALIGN(finfo->size_max, fs_ctx->cfg->program_unit);
 #endif
 
+    /* The scratch blocks must be erased before this update writes to them */
+    err = its_flash_fs_mblock_erase_scratch_blocks(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
     /* Check if the file already exists */
     err = its_flash_fs_mblock_get_file_idx_meta(fs_ctx, fid, &old_idx, &file_meta);
     if (err == PSA_SUCCESS) {
@@ -447,6 +458,12 @@ static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
     del_file_data_idx = file_meta.data_idx;
     del_file_max_size = file_meta.max_size;
 
+    /* The scratch blocks must be erased before this update writes to them */
+    err = its_flash_fs_mblock_erase_scratch_blocks(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
     /* Remove file metadata */
     file_meta = (struct its_file_meta_t){0};
 
@@ -61,6 +61,10 @@ struct its_flash_fs_config_t {
     uint16_t max_file_size;   /**< Maximum file size */
     uint16_t max_num_files;   /**< Maximum number of files */
     uint8_t erase_val;        /**< Value of a byte after erase (usually 0xFF) */
+    bool defer_erase;         /**< Leave the scratch blocks to be erased by
+                               *   its_flash_fs_erase_scratch_blocks() rather
+                               *   than at the end of each update
+                               */
 };
 
 /**
@@ -286,6 +290,22 @@ psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
 psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
                                       const uint8_t *fid);
 
+/**
+ * \brief Erases the scratch blocks left by the last update, when erasing them
+ *        is deferred by the filesystem configuration. Otherwise, or if they
+ *        have already been erased, this does nothing.
+ *
+ * \details Erasing the scratch blocks is the slowest step of an update. When it
+ *          is deferred, calling this function when the system is otherwise
+ *          idle keeps it out of the next write or delete, which has to erase
+ *          the blocks first if they are still pending.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_erase_scratch_blocks(struct its_flash_fs_ctx_t *fs_ctx);
+
 #ifdef __cplusplus
 }
 #endif
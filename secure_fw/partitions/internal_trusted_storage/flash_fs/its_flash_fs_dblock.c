@@ -55,6 +55,7 @@ psa_status_t its_flash_fs_dblock_compact_block(
 
     /* Save scratch data block physical IDs */
     scratch_id = its_flash_fs_mblock_cur_data_scratch_id(fs_ctx, lblock);
+    its_flash_fs_mblock_use_data_scratch(fs_ctx, lblock);
 
     /* Check if there are bytes to be compacted */
     if (size > 0) {
@@ -149,6 +150,7 @@ psa_status_t its_flash_fs_dblock_write_file(
 
     scratch_id = its_flash_fs_mblock_cur_data_scratch_id(fs_ctx,
                                                          file_meta->lblock);
+    its_flash_fs_mblock_use_data_scratch(fs_ctx, file_meta->lblock);
 
     /* Calculate the position of the new file data in the block */
     pos = file_meta->data_idx + offset;
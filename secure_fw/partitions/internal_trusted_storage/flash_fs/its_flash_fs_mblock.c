@@ -505,43 +505,6 @@ static uint32_t its_get_free_file_index(struct its_flash_fs_ctx_t *fs_ctx,
     return ITS_METADATA_INVALID_INDEX;
 }
 
-/**
- * \brief Erases data and meta scratch blocks.
- *
- * \param[in,out] fs_ctx  Filesystem context
- *
- * \return Returns error code as specified in \ref psa_status_t
- */
-static psa_status_t its_mblock_erase_scratch_blocks(
-                                              struct its_flash_fs_ctx_t *fs_ctx)
-{
-    psa_status_t err;
-    uint32_t scratch_datablock;
-
-    /* For the atomicity of the data update process
-     * and power-failure-safe operation, it is necessary that
-     * metadata scratch block is erased before data block.
-     */
-    err = fs_ctx->ops->erase(fs_ctx->cfg, fs_ctx->scratch_metablock);
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
-
-    /* If the number of blocks is bigger than 2, the code needs to erase the
-     * scratch block used to process any change in the data block which contains
-     * only data. Otherwise, if the number of blocks is equal to 2, it means
-     * that all data is stored in the metadata block.
-     */
-    if (fs_ctx->cfg->num_blocks > 2) {
-        scratch_datablock =
-            its_flash_fs_mblock_cur_data_scratch_id(fs_ctx,
-                                                    (ITS_LOGICAL_DBLOCK0 + 1));
-        err = fs_ctx->ops->erase(fs_ctx->cfg, scratch_datablock);
-    }
-
-    return err;
-}
-
 /**
  * \brief Updates scratch block meta.
  *
@@ -863,6 +826,12 @@ static psa_status_t its_mblock_read_meta_header(
 /**
  * \brief Reserves space for an file.
  *
+ * \details The file is placed in the logical block with the least free space
+ *          that can still hold it, so that the large free areas are kept for
+ *          large files instead of being split by small ones. On a tie, the
+ *          lowest logical block is used, which favours logical block 0 as an
+ *          update of a file in it doesn't also need the scratch data block.
+ *
  * \param[in,out] fs_ctx      Filesystem context
  * \param[in]     fid         File ID
  * \param[in]     size        Size of the file for which space is reserve
@@ -879,32 +848,47 @@ static psa_status_t its_mblock_reserve_file(struct its_flash_fs_ctx_t *fs_ctx,
                                             struct its_block_meta_t *block_meta)
 {
     psa_status_t err;
+    struct its_block_meta_t cur_block_meta;
+    uint32_t best_lblock = ITS_BLOCK_INVALID_ID;
     uint32_t i;
 
     for (i = 0; i < its_num_active_dblocks(fs_ctx); i++) {
-        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, i, block_meta);
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, i,
+                                                      &cur_block_meta);
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
         }
 
-        if (block_meta->free_size >= size) {
-            /* Set file metadata */
-            file_meta->lblock = i;
-            file_meta->data_idx = fs_ctx->cfg->block_size
-                                  - block_meta->free_size;
-            file_meta->max_size = size;
-            memcpy(file_meta->id, fid, ITS_FILE_ID_SIZE);
-            file_meta->cur_size = 0;
-            file_meta->flags = flags;
-
-            /* Update block metadata */
-            block_meta->free_size -= size;
-            return PSA_SUCCESS;
+        if ((cur_block_meta.free_size >= size) &&
+            ((best_lblock == ITS_BLOCK_INVALID_ID) ||
+             (cur_block_meta.free_size < block_meta->free_size))) {
+            best_lblock = i;
+            *block_meta = cur_block_meta;
+
+            if (block_meta->free_size == size) {
+                /* An exact fit can't be improved on */
+                break;
+            }
         }
     }
 
-    /* No block has large enough space to fit the requested file */
-    return PSA_ERROR_INSUFFICIENT_STORAGE;
+    if (best_lblock == ITS_BLOCK_INVALID_ID) {
+        /* No block has large enough space to fit the requested file */
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    /* Set file metadata */
+    file_meta->lblock = best_lblock;
+    file_meta->data_idx = fs_ctx->cfg->block_size - block_meta->free_size;
+    file_meta->max_size = size;
+    memcpy(file_meta->id, fid, ITS_FILE_ID_SIZE);
+    file_meta->cur_size = 0;
+    file_meta->flags = flags;
+
+    /* Update block metadata */
+    block_meta->free_size -= size;
+
+    return PSA_SUCCESS;
 }
 
 /**
@@ -1069,9 +1053,12 @@ psa_status_t its_flash_fs_mblock_init(struct its_flash_fs_ctx_t *fs_ctx)
     }
 
     /* Erase the other scratch metadata block. It can be used in the later
-     * step.
+     * step. The state of the scratch blocks is unknown after a reset, so they
+     * are always erased here.
      */
-    err = its_mblock_erase_scratch_blocks(fs_ctx);
+    fs_ctx->scratch_mblock_erased = false;
+    fs_ctx->scratch_dblock_erased = false;
+    err = its_flash_fs_mblock_erase_scratch_blocks(fs_ctx);
     if (err != PSA_SUCCESS) {
         return PSA_ERROR_GENERIC_ERROR;
     }
@@ -1099,9 +1086,61 @@ psa_status_t its_flash_fs_mblock_meta_update_finalize(
 
     /* Update the running context */
     its_mblock_swap_metablocks(fs_ctx);
+    fs_ctx->scratch_mblock_erased = false;
+
+    if (fs_ctx->cfg->defer_erase) {
+        /* The scratch blocks are erased later, at the latest when the next
+         * update starts. Until then, the scratch metadata block holds the
+         * previous metadata, which is discarded at initialization because of
+         * its lower swap count.
+         */
+        return PSA_SUCCESS;
+    }
 
     /* Erase meta block and current scratch block */
-    return its_mblock_erase_scratch_blocks(fs_ctx);
+    return its_flash_fs_mblock_erase_scratch_blocks(fs_ctx);
+}
+
+psa_status_t its_flash_fs_mblock_erase_scratch_blocks(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+    uint32_t scratch_datablock;
+
+    /* For the atomicity of the data update process
+     * and power-failure-safe operation, it is necessary that
+     * metadata scratch block is erased before data block.
+     */
+    if (!fs_ctx->scratch_mblock_erased) {
+        err = fs_ctx->ops->erase(fs_ctx->cfg, fs_ctx->scratch_metablock);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        fs_ctx->scratch_mblock_erased = true;
+    }
+
+    /* If the number of blocks is bigger than 2, the code needs to erase the
+     * scratch block used to process any change in the data block which contains
+     * only data. Otherwise, if the number of blocks is equal to 2, it means
+     * that all data is stored in the metadata block.
+     * Most updates only change files in logical data block 0, or delete files,
+     * without touching the scratch data block, so it is only erased again if
+     * it has been written or swapped with a data block since its last erase.
+     */
+    if ((fs_ctx->cfg->num_blocks > 2) && !fs_ctx->scratch_dblock_erased) {
+        scratch_datablock =
+            its_flash_fs_mblock_cur_data_scratch_id(fs_ctx,
+                                                    (ITS_LOGICAL_DBLOCK0 + 1));
+        err = fs_ctx->ops->erase(fs_ctx->cfg, scratch_datablock);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        fs_ctx->scratch_dblock_erased = true;
+    }
+
+    return PSA_SUCCESS;
 }
 
 psa_status_t its_flash_fs_mblock_migrate_lb0_data_to_scratch(
@@ -1250,6 +1289,8 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
     fs_ctx->meta_block_header.active_swap_count =
                                     (fs_ctx->cfg->erase_val == 0x00U) ? 1U : 0U;
     fs_ctx->meta_block_header.scratch_dblock = its_init_scratch_dblock(fs_ctx);
+    fs_ctx->scratch_mblock_erased = false;
+    fs_ctx->scratch_dblock_erased = false;
     fs_ctx->meta_block_header.fs_version = ITS_SUPPORTED_VERSION;
     fs_ctx->scratch_metablock = ITS_METADATA_BLOCK1;
     fs_ctx->active_metablock = ITS_METADATA_BLOCK0;
@@ -1335,6 +1376,15 @@ void its_flash_fs_mblock_set_data_scratch(struct its_flash_fs_ctx_t *fs_ctx,
 {
     if (lblock != ITS_LOGICAL_DBLOCK0) {
         fs_ctx->meta_block_header.scratch_dblock = phy_id;
+        fs_ctx->scratch_dblock_erased = false;
+    }
+}
+
+void its_flash_fs_mblock_use_data_scratch(struct its_flash_fs_ctx_t *fs_ctx,
+                                          uint32_t lblock)
+{
+    if (lblock != ITS_LOGICAL_DBLOCK0) {
+        fs_ctx->scratch_dblock_erased = false;
     }
 }
 
@@ -192,6 +192,12 @@ struct its_flash_fs_ctx_t {
                                                            */
     uint32_t active_metablock;  /**< Active metadata block */
     uint32_t scratch_metablock; /**< Scratch metadata block */
+    bool scratch_mblock_erased; /**< Whether the scratch metadata block is
+                                 *   known to be erased
+                                 */
+    bool scratch_dblock_erased; /**< Whether the scratch data block is known
+                                 *   to be erased
+                                 */
 };
 
 /**
@@ -217,6 +223,17 @@ psa_status_t its_flash_fs_mblock_cp_file_meta(struct its_flash_fs_ctx_t *fs_ctx,
                                               uint32_t idx_start,
                                               uint32_t idx_end);
 
+/**
+ * \brief Erases the scratch metadata and data blocks, unless they are already
+ *        known to be erased.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_erase_scratch_blocks(
+                                             struct its_flash_fs_ctx_t *fs_ctx);
+
 /**
  * \brief Gets current scratch datablock physical ID.
  *
@@ -376,6 +393,16 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
 void its_flash_fs_mblock_set_data_scratch(struct its_flash_fs_ctx_t *fs_ctx,
                                           uint32_t phy_id, uint32_t lblock);
 
+/**
+ * \brief Records that the scratch block of a logical block is about to be
+ *        written, so that it is erased again before it is reused.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     lblock  Logical block number
+ */
+void its_flash_fs_mblock_use_data_scratch(struct its_flash_fs_ctx_t *fs_ctx,
+                                          uint32_t lblock);
+
 /**
  * \brief Puts logical block's metadata in scratch metadata block
  *
@@ -60,6 +60,7 @@ static struct its_flash_fs_config_t fs_cfg_its = {
     .program_unit = ITS_FLASH_ALIGNMENT,
     .max_file_size = ITS_UTILS_ALIGN(ITS_MAX_ASSET_SIZE, ITS_FLASH_ALIGNMENT),
     .max_num_files = ITS_NUM_ASSETS + 1, /* Extra file for atomic replacement */
+    .defer_erase = (ITS_DEFER_SCRATCH_ERASE != 0),
 };
 #endif /* TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
 
@@ -70,6 +71,7 @@ static struct its_flash_fs_config_t fs_cfg_ps = {
     .program_unit = PS_FLASH_ALIGNMENT,
     .max_file_size = ITS_UTILS_ALIGN(PS_MAX_OBJECT_SIZE, PS_FLASH_ALIGNMENT),
     .max_num_files = PS_MAX_NUM_OBJECTS,
+    .defer_erase = (PS_DEFER_SCRATCH_ERASE != 0),
 };
 #endif
 
@@ -668,3 +670,24 @@ psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid)
     /* Delete old file from the persistent area */
     return its_flash_fs_file_delete(get_fs_ctx(client_id), g_fid);
 }
+
+psa_status_t tfm_its_maintain_storage(void)
+{
+    psa_status_t status = PSA_SUCCESS;
+
+#ifdef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+    status = its_flash_fs_erase_scratch_blocks(&fs_ctx_its);
+    if (status != PSA_SUCCESS) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
+#ifdef TFM_PARTITION_PROTECTED_STORAGE
+    status = its_flash_fs_erase_scratch_blocks(&fs_ctx_ps);
+    if (status != PSA_SUCCESS) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
+    return status;
+}
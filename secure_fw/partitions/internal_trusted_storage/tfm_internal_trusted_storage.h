@@ -163,6 +163,18 @@ psa_status_t tfm_its_get_info(int32_t client_id, psa_storage_uid_t uid,
  */
 psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid);
 
+/**
+ * \brief Does the filesystem maintenance deferred by previous updates, which
+ *        is erasing the scratch blocks they left behind.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                The operation completed successfully
+ * \retval PSA_ERROR_STORAGE_FAILURE  The operation failed because the physical
+ *                                    storage has failed (Fatal error)
+ */
+psa_status_t tfm_its_maintain_storage(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -163,6 +163,8 @@ psa_status_t tfm_internal_trusted_storage_service_sfn(const psa_msg_t *msg)
         return tfm_its_get_info_req(msg);
     case TFM_ITS_REMOVE:
         return tfm_its_remove_req(msg);
+    case TFM_ITS_MAINTAIN:
+        return tfm_its_maintain_storage();
     default:
         return PSA_ERROR_NOT_SUPPORTED;
     }
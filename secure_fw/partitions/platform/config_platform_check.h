@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CONFIG_PARTITION_PLATFORM_H__
+#define __CONFIG_PARTITION_PLATFORM_H__
+
+#include "config_tfm.h"
+
+/* Check invalid configs. */
+#if PLATFORM_NV_COUNTER_CACHE && PLATFORM_NV_COUNTER_MODULE_DISABLED
+#error "Invalid config: PLATFORM_NV_COUNTER_CACHE and PLATFORM_NV_COUNTER_MODULE_DISABLED!"
+#endif
+
+#if PLATFORM_NV_COUNTER_CACHE && defined(PLATFORM_HAS_NV_COUNTER_WRITERS_OUTSIDE_SERVICE)
+#error "Invalid config: PLATFORM_NV_COUNTER_CACHE and PLATFORM_HAS_NV_COUNTER_WRITERS_OUTSIDE_SERVICE!"
+#endif
+
+#endif /* __CONFIG_PARTITION_PLATFORM_H__ */
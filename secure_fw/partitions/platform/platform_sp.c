@@ -6,6 +6,7 @@
  */
 
 #include "config_tfm.h"
+#include "config_platform_check.h"
 #include "platform_sp.h"
 
 #include "tfm_platform_system.h"
@@ -14,6 +15,11 @@
 
 #if !PLATFORM_NV_COUNTER_MODULE_DISABLED
 #include "tfm_plat_nv_counters.h"
+#if PLATFORM_NV_COUNTER_CACHE
+#include <stdbool.h>
+#include <string.h>
+#include "fih.h"
+#endif /* PLATFORM_NV_COUNTER_CACHE */
 #endif /* !PLATFORM_NV_COUNTER_MODULE_DISABLED */
 
 #include "psa/client.h"
@@ -24,6 +30,23 @@
 #if !PLATFORM_NV_COUNTER_MODULE_DISABLED
 #define NV_COUNTER_ID_SIZE  sizeof(enum tfm_nv_counter_t)
 #define NV_COUNTER_SIZE     4
+
+#if PLATFORM_NV_COUNTER_CACHE
+/*
+ * RAM copy of the NV counters read through the service, so that repeated reads
+ * don't go to the NV counter backend, e.g. OTP. A counter is cached on its
+ * first successful read and the copy is updated on every increment done
+ * through the service. The values are stored as fih_int so that a tampered
+ * copy is caught when it is used. Nothing else may write the counters while
+ * the secure firmware runs, which config_platform_check.h enforces.
+ */
+struct nv_counter_cache_entry_t {
+    fih_int value;      /* Cached value of the counter */
+    bool is_valid;      /* Whether value holds the value of the counter */
+};
+
+static struct nv_counter_cache_entry_t nv_counter_cache[PLAT_NV_COUNTER_MAX];
+#endif /* PLATFORM_NV_COUNTER_CACHE */
 #endif /* !PLATFORM_NV_COUNTER_MODULE_DISABLED */
 
 typedef enum tfm_platform_err_t (*plat_func_t)(const psa_msg_t *msg);
@@ -47,6 +70,76 @@ static psa_status_t platform_sp_system_reset_psa_api(const psa_msg_t *msg)
 }
 
 #if !PLATFORM_NV_COUNTER_MODULE_DISABLED
+static enum tfm_plat_err_t platform_sp_nv_read(enum tfm_nv_counter_t counter_id,
+                                               uint32_t size, uint8_t *val)
+{
+#if PLATFORM_NV_COUNTER_CACHE
+    enum tfm_plat_err_t err;
+    uint32_t value;
+
+    /* Other sizes are left to the platform, which decides how to handle them */
+    if ((counter_id >= PLAT_NV_COUNTER_MAX) || (size != NV_COUNTER_SIZE)) {
+        return tfm_plat_read_nv_counter(counter_id, size, val);
+    }
+
+    if (!nv_counter_cache[counter_id].is_valid) {
+        err = tfm_plat_read_nv_counter(counter_id, sizeof(value),
+                                       (uint8_t *)&value);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+
+        nv_counter_cache[counter_id].value = fih_int_encode(value);
+        nv_counter_cache[counter_id].is_valid = true;
+    }
+
+    value = fih_int_decode(nv_counter_cache[counter_id].value);
+    memcpy(val, &value, sizeof(value));
+
+    return TFM_PLAT_ERR_SUCCESS;
+#else
+    return tfm_plat_read_nv_counter(counter_id, size, val);
+#endif /* PLATFORM_NV_COUNTER_CACHE */
+}
+
+static enum tfm_plat_err_t platform_sp_nv_increment(enum tfm_nv_counter_t counter_id)
+{
+#if PLATFORM_NV_COUNTER_CACHE
+    enum tfm_plat_err_t err;
+    uint32_t value;
+    fih_int expected;
+
+    err = tfm_plat_increment_nv_counter(counter_id);
+    if ((err != TFM_PLAT_ERR_SUCCESS) || (counter_id >= PLAT_NV_COUNTER_MAX) ||
+        !nv_counter_cache[counter_id].is_valid) {
+        return err;
+    }
+
+    /* Write-through: the copy is only kept if the backend holds the
+     * incremented value. Otherwise the counter has been changed behind the
+     * service, and it is read from the backend again on its next read.
+     */
+    nv_counter_cache[counter_id].is_valid = false;
+
+    err = tfm_plat_read_nv_counter(counter_id, sizeof(value), (uint8_t *)&value);
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    expected = fih_int_encode(fih_int_decode(nv_counter_cache[counter_id].value) + 1);
+    if (fih_not_eq(fih_int_encode(value), expected)) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    nv_counter_cache[counter_id].value = expected;
+    nv_counter_cache[counter_id].is_valid = true;
+
+    return TFM_PLAT_ERR_SUCCESS;
+#else
+    return tfm_plat_increment_nv_counter(counter_id);
+#endif /* PLATFORM_NV_COUNTER_CACHE */
+}
+
 static psa_status_t platform_sp_nv_read_psa_api(const psa_msg_t *msg)
 {
     enum tfm_plat_err_t err = TFM_PLAT_ERR_SYSTEM_ERR;
@@ -88,8 +181,7 @@ static psa_status_t platform_sp_nv_read_psa_api(const psa_msg_t *msg)
        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
     }
 
-    err = tfm_plat_read_nv_counter(counter_id,  msg->out_size[0],
-                                   counter_val);
+    err = platform_sp_nv_read(counter_id, msg->out_size[0], counter_val);
 
     if (err != TFM_PLAT_ERR_SUCCESS) {
        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
@@ -139,7 +231,7 @@ static psa_status_t platform_sp_nv_increment_psa_api(const psa_msg_t *msg)
        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
     }
 
-    err = tfm_plat_increment_nv_counter(counter_id);
+    err = platform_sp_nv_increment(counter_id);
 
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return TFM_PLATFORM_ERR_SYSTEM_ERROR;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2024, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -49,6 +49,21 @@ typedef char PS_ERROR_NOT_AEAD_ALG[(PSA_ALG_IS_AEAD(PS_CRYPTO_ALG)) ? 1 : -1];
 
 static uint8_t ps_crypto_iv_buf[PS_IV_LEN_BYTES];
 
+#if PS_CRYPTO_KEY_CACHE_SIZE > 0
+/* Structure holding a derived storage key which is kept resident in the
+ * Crypto service, together with the label it was derived from.
+ */
+struct ps_crypto_key_entry_t {
+    uint8_t label[LABEL_LEN]; /*!< Label used to derive the key */
+    psa_key_id_t key;         /*!< Handle of the derived key */
+    uint32_t last_used;       /*!< Value of the use counter when last used */
+    bool is_valid;            /*!< Whether the entry holds a key */
+};
+
+static struct ps_crypto_key_entry_t ps_crypto_key_cache[PS_CRYPTO_KEY_CACHE_SIZE];
+static uint32_t ps_crypto_key_use_counter;
+#endif /* PS_CRYPTO_KEY_CACHE_SIZE > 0 */
+
 static void fill_key_label(const union ps_crypto_t *crypto,
                            uint8_t *label)
 {
@@ -126,6 +141,100 @@ err_release_op:
     return PSA_ERROR_GENERIC_ERROR;
 }
 
+/**
+ * \brief Gets the storage key for the given label. If key caching is enabled,
+ *        a key already derived for the label is reused, otherwise the key is
+ *        derived and replaces the least recently used one in the cache.
+ *
+ * \param[in]  key_label  Pointer to the key label, of LABEL_LEN bytes
+ * \param[out] ps_key     On success, the handle of the storage key
+ *
+ * \return Returns values as described in \ref psa_status_t
+ */
+static psa_status_t ps_crypto_get_key(const uint8_t *key_label,
+                                      psa_key_id_t *ps_key)
+{
+#if PS_CRYPTO_KEY_CACHE_SIZE > 0
+    struct ps_crypto_key_entry_t *entry = &ps_crypto_key_cache[0];
+    psa_status_t status;
+    uint32_t idx;
+
+    for (idx = 0; idx < PS_CRYPTO_KEY_CACHE_SIZE; idx++) {
+        struct ps_crypto_key_entry_t *cur = &ps_crypto_key_cache[idx];
+
+        if (cur->is_valid && memcmp(cur->label, key_label, LABEL_LEN) == 0) {
+            entry = cur;
+            goto out;
+        }
+
+        /* Keep track of the best candidate for eviction */
+        if (entry->is_valid
+            && (!cur->is_valid || cur->last_used < entry->last_used)) {
+            entry = cur;
+        }
+    }
+
+    if (entry->is_valid) {
+        (void)psa_destroy_key(entry->key);
+        entry->is_valid = false;
+    }
+
+    status = ps_crypto_setkey(&entry->key, key_label, LABEL_LEN);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    (void)memcpy(entry->label, key_label, LABEL_LEN);
+    entry->is_valid = true;
+
+out:
+    entry->last_used = ++ps_crypto_key_use_counter;
+    *ps_key = entry->key;
+
+    return PSA_SUCCESS;
+#else
+    return ps_crypto_setkey(ps_key, key_label, LABEL_LEN);
+#endif /* PS_CRYPTO_KEY_CACHE_SIZE > 0 */
+}
+
+/**
+ * \brief Releases a storage key obtained with \ref ps_crypto_get_key. Cached
+ *        keys stay resident until evicted or flushed.
+ *
+ * \param[in] ps_key  Handle of the storage key
+ *
+ * \return Returns values as described in \ref psa_status_t
+ */
+static psa_status_t ps_crypto_put_key(psa_key_id_t ps_key)
+{
+#if PS_CRYPTO_KEY_CACHE_SIZE > 0
+    (void)ps_key;
+
+    return PSA_SUCCESS;
+#else
+    /* Destroy the transient key */
+    if (psa_destroy_key(ps_key) != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+#endif /* PS_CRYPTO_KEY_CACHE_SIZE > 0 */
+}
+
+void ps_crypto_flush_keys(void)
+{
+#if PS_CRYPTO_KEY_CACHE_SIZE > 0
+    uint32_t idx;
+
+    for (idx = 0; idx < PS_CRYPTO_KEY_CACHE_SIZE; idx++) {
+        if (ps_crypto_key_cache[idx].is_valid) {
+            (void)psa_destroy_key(ps_crypto_key_cache[idx].key);
+            ps_crypto_key_cache[idx].is_valid = false;
+        }
+    }
+#endif /* PS_CRYPTO_KEY_CACHE_SIZE > 0 */
+}
+
 psa_status_t ps_crypto_init(void)
 {
     /* For GCM and CCM it is essential that nonce doesn't get repeated. If there
@@ -225,7 +334,7 @@ psa_status_t ps_crypto_encrypt_and_tag(union ps_crypto_t *crypto,
 
     fill_key_label(crypto, label);
 
-    status = ps_crypto_setkey(&ps_key, label, sizeof(label));
+    status = ps_crypto_get_key(label, &ps_key);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -236,7 +345,7 @@ psa_status_t ps_crypto_encrypt_and_tag(union ps_crypto_t *crypto,
                               in, in_len,
                               out, out_size, out_len);
     if (status != PSA_SUCCESS) {
-        (void)psa_destroy_key(ps_key);
+        (void)ps_crypto_put_key(ps_key);
         return PSA_ERROR_GENERIC_ERROR;
     }
 
@@ -244,13 +353,7 @@ psa_status_t ps_crypto_encrypt_and_tag(union ps_crypto_t *crypto,
     *out_len -= PS_TAG_LEN_BYTES;
     (void)memcpy(crypto->ref.tag, (out + *out_len), PS_TAG_LEN_BYTES);
 
-    /* Destroy the transient key */
-    status = psa_destroy_key(ps_key);
-    if (status != PSA_SUCCESS) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    return PSA_SUCCESS;
+    return ps_crypto_put_key(ps_key);
 }
 
 psa_status_t ps_crypto_auth_and_decrypt(const union ps_crypto_t *crypto,
@@ -272,7 +375,7 @@ psa_status_t ps_crypto_auth_and_decrypt(const union ps_crypto_t *crypto,
     (void)memcpy((in + in_len), crypto->ref.tag, PS_TAG_LEN_BYTES);
     in_len += PS_TAG_LEN_BYTES;
 
-    status = ps_crypto_setkey(&ps_key, label, sizeof(label));
+    status = ps_crypto_get_key(label, &ps_key);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -283,17 +386,11 @@ psa_status_t ps_crypto_auth_and_decrypt(const union ps_crypto_t *crypto,
                               in, in_len,
                               out, out_size, out_len);
     if (status != PSA_SUCCESS) {
-        (void)psa_destroy_key(ps_key);
+        (void)ps_crypto_put_key(ps_key);
         return PSA_ERROR_INVALID_SIGNATURE;
     }
 
-    /* Destroy the transient key */
-    status = psa_destroy_key(ps_key);
-    if (status != PSA_SUCCESS) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    return PSA_SUCCESS;
+    return ps_crypto_put_key(ps_key);
 }
 
 psa_status_t ps_crypto_generate_auth_tag(union ps_crypto_t *crypto,
@@ -307,7 +404,7 @@ psa_status_t ps_crypto_generate_auth_tag(union ps_crypto_t *crypto,
 
     fill_key_label(crypto, label);
 
-    status = ps_crypto_setkey(&ps_key, label, sizeof(label));
+    status = ps_crypto_get_key(label, &ps_key);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -318,17 +415,11 @@ psa_status_t ps_crypto_generate_auth_tag(union ps_crypto_t *crypto,
                               0, 0,
                               crypto->ref.tag, PS_TAG_LEN_BYTES, &out_len);
     if (status != PSA_SUCCESS || out_len != PS_TAG_LEN_BYTES) {
-        (void)psa_destroy_key(ps_key);
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    /* Destroy the transient key */
-    status = psa_destroy_key(ps_key);
-    if (status != PSA_SUCCESS) {
+        (void)ps_crypto_put_key(ps_key);
         return PSA_ERROR_GENERIC_ERROR;
     }
 
-    return PSA_SUCCESS;
+    return ps_crypto_put_key(ps_key);
 }
 
 psa_status_t ps_crypto_authenticate(const union ps_crypto_t *crypto,
@@ -342,7 +433,7 @@ psa_status_t ps_crypto_authenticate(const union ps_crypto_t *crypto,
 
     fill_key_label(crypto, label);
 
-    status = ps_crypto_setkey(&ps_key, label, sizeof(label));
+    status = ps_crypto_get_key(label, &ps_key);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -353,17 +444,11 @@ psa_status_t ps_crypto_authenticate(const union ps_crypto_t *crypto,
                               crypto->ref.tag, PS_TAG_LEN_BYTES,
                               0, 0, &out_len);
     if (status != PSA_SUCCESS || out_len != 0) {
-        (void)psa_destroy_key(ps_key);
+        (void)ps_crypto_put_key(ps_key);
         return PSA_ERROR_INVALID_SIGNATURE;
     }
 
-    /* Destroy the transient key */
-    status = psa_destroy_key(ps_key);
-    if (status != PSA_SUCCESS) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    return PSA_SUCCESS;
+    return ps_crypto_put_key(ps_key);
 }
 
 #ifdef PS_SUPPORT_FORMAT_TRANSITION
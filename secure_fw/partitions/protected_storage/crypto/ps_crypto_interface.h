@@ -45,6 +45,15 @@ union ps_crypto_t {
  */
 psa_status_t ps_crypto_init(void);
 
+/**
+ * \brief Destroys all the storage keys kept resident by the crypto engine.
+ *        Must be called whenever the keys in use are rotated, so that keys
+ *        which are no longer needed do not stay loaded.
+ *
+ * \note This is a no-op if PS_CRYPTO_KEY_CACHE_SIZE is 0.
+ */
+void ps_crypto_flush_keys(void);
+
 /**
  * \brief Convert lengths to block count
  *
@@ -116,6 +116,11 @@ static void ps_switch_key(void)
     }
     g_ps_object.header.crypto.ref.key_gen_nr++;
     g_obj_tbl_info.num_blocks = 0;
+
+    /* Keys of the previous generation are only needed again to read objects
+     * not yet rewritten, so don't keep them resident
+     */
+    ps_crypto_flush_keys();
 }
 #endif /* PS_AES_KEY_USAGE_LIMIT == 0 */
 
@@ -7,29 +7,130 @@
 
 #include "crt_impl_private.h"
 
+/* Copies shorter than this are not worth aligning the pointers for */
+#define COPY_WORD_THRESHOLD           (2 * sizeof(uint32_t))
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define MERGE_WORDS(lo, hi, shift)    (((lo) << (shift)) | ((hi) >> (32 - (shift))))
+#else
+#define MERGE_WORDS(lo, hi, shift)    (((lo) >> (shift)) | ((hi) << (32 - (shift))))
+#endif
+
 void *memcpy(void *dest, const void *src, size_t n)
 {
     union composite_addr_t p_dst, p_src;
+    uint32_t w0, w1, w2, w3, w4, w5, w6, w7;
+    uint32_t shift;
+    union {
+        uint32_t word;
+        uint8_t bytes[sizeof(uint32_t)];
+    } tail;
 
     p_dst.uint_addr = (uintptr_t)dest;
     p_src.uint_addr = (uintptr_t)src;
 
-    /* Byte copy for unaligned address. check the last bit of address. */
-    while (n && (ADDR_WORD_UNALIGNED(p_dst.uint_addr) ||
-                 ADDR_WORD_UNALIGNED(p_src.uint_addr))) {
+    if (n < COPY_WORD_THRESHOLD) {
+        while (n--) {
+            *p_dst.p_byte++ = *p_src.p_byte++;
+        }
+        return dest;
+    }
+
+    /* Byte copy until the destination is word aligned. */
+    while (ADDR_WORD_UNALIGNED(p_dst.uint_addr)) {
         *p_dst.p_byte++ = *p_src.p_byte++;
         n--;
     }
 
-    /* Quad byte copy for aligned address. */
-    while (n >= sizeof(uint32_t)) {
-        *(p_dst.p_word)++ = *(p_src.p_word)++;
-        n -= sizeof(uint32_t);
+    if (!ADDR_WORD_UNALIGNED(p_src.uint_addr)) {
+        /*
+         * Both aligned: move 8 words per iteration. All the loads of a block
+         * are done before its stores, which lets the compiler use LDM/STM and
+         * keeps the forward copy of memmove() correct when src > dest.
+         */
+        while (n >= 8 * sizeof(uint32_t)) {
+            w0 = p_src.p_word[0];
+            w1 = p_src.p_word[1];
+            w2 = p_src.p_word[2];
+            w3 = p_src.p_word[3];
+            w4 = p_src.p_word[4];
+            w5 = p_src.p_word[5];
+            w6 = p_src.p_word[6];
+            w7 = p_src.p_word[7];
+            p_dst.p_word[0] = w0;
+            p_dst.p_word[1] = w1;
+            p_dst.p_word[2] = w2;
+            p_dst.p_word[3] = w3;
+            p_dst.p_word[4] = w4;
+            p_dst.p_word[5] = w5;
+            p_dst.p_word[6] = w6;
+            p_dst.p_word[7] = w7;
+            p_src.p_word += 8;
+            p_dst.p_word += 8;
+            n -= 8 * sizeof(uint32_t);
+        }
+
+        while (n >= sizeof(uint32_t)) {
+            *(p_dst.p_word)++ = *(p_src.p_word)++;
+            n -= sizeof(uint32_t);
+        }
+    } else {
+        /*
+         * Mismatched alignment: read aligned source words and merge each pair
+         * into one destination word. The last source word read can extend up
+         * to 3 bytes past the end of the source, but never out of its aligned
+         * word, so it can't cross a memory protection boundary.
+         */
+        shift = (uint32_t)ADDR_WORD_UNALIGNED(p_src.uint_addr) * 8;
+        p_src.uint_addr &= ~(uintptr_t)0x3;
+        w0 = *(p_src.p_word)++;
+
+        while (n >= 4 * sizeof(uint32_t)) {
+            w1 = p_src.p_word[0];
+            w2 = p_src.p_word[1];
+            w3 = p_src.p_word[2];
+            w4 = p_src.p_word[3];
+            p_dst.p_word[0] = MERGE_WORDS(w0, w1, shift);
+            p_dst.p_word[1] = MERGE_WORDS(w1, w2, shift);
+            p_dst.p_word[2] = MERGE_WORDS(w2, w3, shift);
+            p_dst.p_word[3] = MERGE_WORDS(w3, w4, shift);
+            w0 = w4;
+            p_src.p_word += 4;
+            p_dst.p_word += 4;
+            n -= 4 * sizeof(uint32_t);
+        }
+
+        while (n >= sizeof(uint32_t)) {
+            w1 = *(p_src.p_word)++;
+            *(p_dst.p_word)++ = MERGE_WORDS(w0, w1, shift);
+            w0 = w1;
+            n -= sizeof(uint32_t);
+        }
+
+        /*
+         * The tail is taken from w0 rather than read again, as the stores
+         * above may have overwritten it when memmove() copies forward.
+         */
+        if (n) {
+            w1 = ((shift / 8) + n > sizeof(uint32_t)) ? *p_src.p_word : 0;
+            tail.word = MERGE_WORDS(w0, w1, shift);
+            p_src.p_byte = tail.bytes;
+        }
     }
 
     /* Byte copy for the remaining bytes. */
-    while (n--) {
-        *p_dst.p_byte++ = *p_src.p_byte++;
+    switch (n) {
+    case 3:
+        p_dst.p_byte[2] = p_src.p_byte[2];
+        /* fallthrough */
+    case 2:
+        p_dst.p_byte[1] = p_src.p_byte[1];
+        /* fallthrough */
+    case 1:
+        p_dst.p_byte[0] = p_src.p_byte[0];
+        /* fallthrough */
+    default:
+        break;
     }
 
     return dest;
@@ -21,6 +21,20 @@ void *memset(void *s, int c, size_t n)
         n--;
     }
 
+    /* Unrolled so that the compiler can store a block with STM. */
+    while (n >= 8 * sizeof(uint32_t)) {
+        p_mem.p_word[0] = pattern_word;
+        p_mem.p_word[1] = pattern_word;
+        p_mem.p_word[2] = pattern_word;
+        p_mem.p_word[3] = pattern_word;
+        p_mem.p_word[4] = pattern_word;
+        p_mem.p_word[5] = pattern_word;
+        p_mem.p_word[6] = pattern_word;
+        p_mem.p_word[7] = pattern_word;
+        p_mem.p_word += 8;
+        n -= 8 * sizeof(uint32_t);
+    }
+
     while (n >= sizeof(uint32_t)) {
         *p_mem.p_word++ = pattern_word;
         n -= sizeof(uint32_t);
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_tfm.h"
+#include "memory_check_cache.h"
+#include "utilities.h"
+
+#if CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES > 0
+
+/*
+ * Without the NS client extension, all the NS threads share one client ID
+ * while the result of a check can depend on the NS thread, e.g. on its
+ * privilege level. Ranges are only cached for NS clients when the NS threads
+ * can be told apart.
+ */
+#if defined(TFM_NS_MANAGE_NSID) || defined(TFM_MULTI_CORE_TOPOLOGY)
+#define CACHE_NS_CLIENTS    1
+#else
+#define CACHE_NS_CLIENTS    0
+#endif
+
+struct memory_check_entry_t {
+    uintptr_t boundary;
+    uintptr_t base;
+    uintptr_t limit;           /* Address following the range */
+    uint32_t  access_type;     /* 0 for an unused entry */
+    int32_t   client_id;
+    uintptr_t check;           /* Complement of the fields XORed together */
+};
+
+static struct memory_check_entry_t
+                        cache_entries[CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES];
+static uint32_t next_victim;
+
+static uintptr_t entry_check_value(const struct memory_check_entry_t *entry)
+{
+    return ~(entry->boundary ^ entry->base ^ entry->limit ^
+             (uintptr_t)entry->access_type ^ (uintptr_t)entry->client_id);
+}
+
+static bool entry_covers(const struct memory_check_entry_t *entry,
+                         int32_t client_id, uintptr_t boundary,
+                         uintptr_t base, uintptr_t limit, uint32_t access_type)
+{
+    return (entry->access_type == access_type) &&
+           (entry->client_id == client_id) &&
+           (entry->boundary == boundary) &&
+           (entry->base <= base) && (limit <= entry->limit);
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) spm_memory_check(int32_t client_id,
+                                                     uintptr_t boundary,
+                                                     uintptr_t base,
+                                                     size_t size,
+                                                     uint32_t access_type)
+{
+    fih_int fih_rc = FIH_FAILURE;
+    struct memory_check_entry_t *entry;
+    uintptr_t limit;
+    uint32_t i;
+
+    /* Empty and wrapping ranges are left to the platform */
+    if ((size == 0) || (access_type == 0) || (size > UINTPTR_MAX - base) ||
+        ((client_id < 0) && !CACHE_NS_CLIENTS)) {
+        FIH_CALL(tfm_hal_memory_check, fih_rc, boundary, base, size, access_type);
+        FIH_RET(fih_rc);
+    }
+
+    limit = base + size;
+
+    for (i = 0; i < CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES; i++) {
+        entry = &cache_entries[i];
+        if (!entry_covers(entry, client_id, boundary, base, limit, access_type)) {
+            continue;
+        }
+
+        /*
+         * Check the entry again after a random delay, along with its integrity,
+         * so that a single glitch can't turn a miss into a hit.
+         */
+        (void)fih_delay();
+        if (entry_covers(entry, client_id, boundary, base, limit, access_type) &&
+            (entry->check == entry_check_value(entry))) {
+            FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+        }
+        tfm_core_panic();
+    }
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc, boundary, base, size, access_type);
+    if (fih_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
+        entry = &cache_entries[next_victim];
+        entry->boundary = boundary;
+        entry->base = base;
+        entry->limit = limit;
+        entry->access_type = access_type;
+        entry->client_id = client_id;
+        entry->check = entry_check_value(entry);
+        next_victim = (next_victim + 1) % CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES;
+    }
+
+    FIH_RET(fih_rc);
+}
+
+void spm_memory_check_cache_invalidate(void)
+{
+    spm_memset(cache_entries, 0, sizeof(cache_entries));
+    next_victim = 0;
+}
+
+void spm_memory_check_cache_invalidate_ns(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES; i++) {
+        if (cache_entries[i].client_id < 0) {
+            spm_memset(&cache_entries[i], 0, sizeof(cache_entries[i]));
+        }
+    }
+}
+
+#else /* CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES > 0 */
+
+void spm_memory_check_cache_invalidate(void)
+{
+}
+
+void spm_memory_check_cache_invalidate_ns(void)
+{
+}
+
+#endif /* CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES > 0 */
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __MEMORY_CHECK_CACHE_H__
+#define __MEMORY_CHECK_CACHE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config_tfm.h"
+#include "fih.h"
+#include "tfm_hal_isolation.h"
+
+#if CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES > 0
+
+/**
+ * \brief  Check the access to a memory range on behalf of a client, as
+ *         tfm_hal_memory_check() does. A range inside a range recently
+ *         validated for the same client, boundary and access type is
+ *         accepted without calling the platform again.
+ *
+ * \param[in]   client_id     The client the memory belongs to.
+ * \param[in]   boundary      The boundary the memory is checked with.
+ * \param[in]   base          The base address of the range.
+ * \param[in]   size          The size of the range.
+ * \param[in]   access_type   The memory access types to be checked.
+ *
+ * \return As tfm_hal_memory_check().
+ */
+FIH_RET_TYPE(enum tfm_hal_status_t) spm_memory_check(int32_t client_id,
+                                                     uintptr_t boundary,
+                                                     uintptr_t base,
+                                                     size_t size,
+                                                     uint32_t access_type);
+
+#else /* CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES > 0 */
+
+#define spm_memory_check(client_id, boundary, base, size, access_type) \
+        ((void)(client_id), tfm_hal_memory_check(boundary, base, size, access_type))
+
+#endif /* CONFIG_TFM_MEMORY_CHECK_CACHE_ENTRIES > 0 */
+
+/**
+ * \brief  Forget the ranges validated for NS clients only, for when the NS
+ *         thread changes. The access rights of the NS clients can change with
+ *         the NS thread, those of the secure partitions can't.
+ */
+void spm_memory_check_cache_invalidate_ns(void);
+
+#endif /* __MEMORY_CHECK_CACHE_H__ */
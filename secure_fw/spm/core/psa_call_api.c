@@ -12,10 +12,18 @@
 #include "critical_section.h"
 #include "ffm/backend.h"
 #include "ffm/psa_api.h"
+#include "memory_check_cache.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_psa_call_pack.h"
 #include "utilities.h"
 
+/* Whether input vector a sorts before b, by base address and then by end */
+static inline bool invec_sorts_before(const psa_invec *a, const psa_invec *b)
+{
+    return ((uintptr_t)a->base < (uintptr_t)b->base) ||
+           (((uintptr_t)a->base == (uintptr_t)b->base) && (a->len < b->len));
+}
+
 psa_status_t spm_associate_call_params(struct connection_t *p_connection,
                                        uint32_t            ctrl_param,
                                        const psa_invec     *inptr,
@@ -23,6 +31,8 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
 {
     psa_invec  ivecs_local[PSA_MAX_IOVEC];
     psa_outvec ovecs_local[PSA_MAX_IOVEC];
+    uint8_t    ivec_order[PSA_MAX_IOVEC];
+    uintptr_t  ivec_limit  = 0;
     int        i, j;
     fih_int    fih_rc      = FIH_FAILURE;
     uint32_t   ns_access   = 0;
@@ -30,6 +40,7 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
     size_t     ovec_num    = PARAM_UNPACK_OUT_LEN(ctrl_param);
     const struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
     int32_t type = PARAM_UNPACK_TYPE(ctrl_param);
+    int32_t client_id = p_connection->msg.client_id;
 
     /* The request type must be zero or positive. */
     if (type < 0) {
@@ -58,14 +69,13 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
      * if the memory reference for the wrap input vector is invalid or not
      * readable.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc, client_id,
              curr_partition->boundary, (uintptr_t)inptr,
              ivec_num * sizeof(psa_invec), TFM_HAL_ACCESS_READABLE | ns_access);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    spm_memset(ivecs_local, 0, sizeof(ivecs_local));
     spm_memcpy(ivecs_local, inptr, ivec_num * sizeof(psa_invec));
 
     /*
@@ -73,47 +83,36 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
      * actual length later. It is a PROGRAMMER ERROR if the memory reference for
      * the wrap output vector is invalid or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc, client_id,
              curr_partition->boundary, (uintptr_t)outptr,
              ovec_num * sizeof(psa_outvec), TFM_HAL_ACCESS_READWRITE | ns_access);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    spm_memset(ovecs_local, 0, sizeof(ovecs_local));
     spm_memcpy(ovecs_local, outptr, ovec_num * sizeof(psa_outvec));
 
-    /*
-     * Clients must never overlap input parameters because of the risk of a
-     * double-fetch inconsistency.
-     * Overflow is checked in tfm_hal_memory_check functions.
-     */
-    for (i = 0; (i + 1) < ivec_num; i++) {
-        for (j = i + 1; j < ivec_num; j++) {
-            if (!((((char *) ivecs_local[j].base + ivecs_local[j].len) <=
-                  (char *) ivecs_local[i].base) ||
-                  ((char *) ivecs_local[j].base >=
-                  ((char *) ivecs_local[i].base + ivecs_local[i].len)))) {
-                return PSA_ERROR_PROGRAMMER_ERROR;
-            }
-        }
-    }
-
     if (PARAM_IS_NS_INVEC(ctrl_param)) {
         /* Vector descriptor is non-secure then vectors are non-secure. */
         ns_access = TFM_HAL_ACCESS_NS;
     }
 
-    /* Make sure in_size and out_size arrays in the msg structure are cleared first */
-    spm_memset(p_connection->msg.in_size, 0, sizeof(p_connection->msg.in_size));
-    spm_memset(p_connection->msg.out_size, 0, sizeof(p_connection->msg.out_size));
+    /*
+     * Clear the in_size and out_size entries of the msg structure which are
+     * not filled in by the vectors below.
+     */
+    spm_memset(&p_connection->msg.in_size[ivec_num], 0,
+               (PSA_MAX_IOVEC - ivec_num) * sizeof(p_connection->msg.in_size[0]));
+    spm_memset(&p_connection->msg.out_size[ovec_num], 0,
+               (PSA_MAX_IOVEC - ovec_num) * sizeof(p_connection->msg.out_size[0]));
 
     /*
      * For client input vector, it is a PROGRAMMER ERROR if the provided payload
-     * memory reference was invalid or not readable.
+     * memory reference was invalid or not readable. Each checked vector is
+     * inserted into ivec_order, which is kept sorted for the overlap check.
      */
     for (i = 0; i < ivec_num; i++) {
-        FIH_CALL(tfm_hal_memory_check, fih_rc,
+        FIH_CALL(spm_memory_check, fih_rc, client_id,
                  curr_partition->boundary, (uintptr_t)ivecs_local[i].base,
                  ivecs_local[i].len, TFM_HAL_ACCESS_READABLE | ns_access);
         if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -123,6 +122,30 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
         p_connection->msg.in_size[i]    = ivecs_local[i].len;
         p_connection->invec_base[i]     = ivecs_local[i].base;
         p_connection->invec_accessed[i] = 0;
+
+        for (j = i; (j > 0) &&
+             invec_sorts_before(&ivecs_local[i], &ivecs_local[ivec_order[j - 1]]);
+             j--) {
+            ivec_order[j] = ivec_order[j - 1];
+        }
+        ivec_order[j] = (uint8_t)i;
+    }
+
+    /*
+     * Clients must never overlap input parameters because of the risk of a
+     * double-fetch inconsistency. In base address order, a vector overlaps an
+     * earlier one if it starts below the highest end seen so far.
+     * Overflow is checked in tfm_hal_memory_check functions.
+     */
+    for (i = 0; i < ivec_num; i++) {
+        const psa_invec *p_ivec = &ivecs_local[ivec_order[i]];
+
+        if ((uintptr_t)p_ivec->base < ivec_limit) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        if (((uintptr_t)p_ivec->base + p_ivec->len) > ivec_limit) {
+            ivec_limit = (uintptr_t)p_ivec->base + p_ivec->len;
+        }
     }
 
     if ((ns_access == TFM_HAL_ACCESS_NS) &&
@@ -136,7 +159,7 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
      * payload memory reference was invalid or not read-write.
      */
     for (i = 0; i < ovec_num; i++) {
-        FIH_CALL(tfm_hal_memory_check, fih_rc,
+        FIH_CALL(spm_memory_check, fih_rc, client_id,
                  curr_partition->boundary, (uintptr_t)ovecs_local[i].base,
                  ovecs_local[i].len, TFM_HAL_ACCESS_READWRITE | ns_access);
         if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -74,8 +74,8 @@ size_t tfm_spm_partition_psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
 
     bytes = (num_bytes < remaining) ? num_bytes : remaining;
 
-    spm_memcpy(buffer, (char *)handle->invec_base[invec_idx] +
-                               handle->invec_accessed[invec_idx], bytes);
+    spm_iovec_copy(buffer, (char *)handle->invec_base[invec_idx] +
+                                   handle->invec_accessed[invec_idx], bytes);
 
     /* Update the data size read */
     handle->invec_accessed[invec_idx] += bytes;
@@ -205,8 +205,8 @@ psa_status_t tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outve
         tfm_core_panic();
     }
 
-    spm_memcpy((char *)handle->outvec_base[outvec_idx] +
-               handle->outvec_written[outvec_idx], buffer, num_bytes);
+    spm_iovec_copy((char *)handle->outvec_base[outvec_idx] +
+                   handle->outvec_written[outvec_idx], buffer, num_bytes);
 
     /* Update the data size written */
     handle->outvec_written[outvec_idx] += num_bytes;
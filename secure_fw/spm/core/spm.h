@@ -21,6 +21,7 @@
 #include "runtime_defs.h"
 #include "thread.h"
 #include "psa/service.h"
+#include "ffm/psa_api.h"
 #include "load/partition_defs.h"
 #include "load/interrupt_defs.h"
 
@@ -93,7 +94,7 @@ struct connection_t {
                                               */
 #endif
 #if PSA_FRAMEWORK_HAS_MM_IOVEC
-    uint32_t iovec_status;                   /* MM-IOVEC status                */
+    uint32_t iovec_status[IOVEC_STATUS_WORDS]; /* MM-IOVEC status              */
 #endif
 #if CONFIG_TFM_SPM_BACKEND_IPC == 1
     struct connection_t *p_reqs;             /* Request handle(s) link         */
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tfm_hal_dma_copy.h"
+#include "utilities.h"
+
+/*
+ * A copy is split in two parts running concurrently: the DMA copies the head
+ * while the CPU copies the tail. The CPU share is counted in sixteenths of
+ * the copy and adjusted after each copy, depending on which part completed
+ * first, so that both parts tend to complete at the same time.
+ */
+#define CPU_SHARE_DENOMINATOR   16
+#define CPU_SHARE_MAX           (CPU_SHARE_DENOMINATOR - 1)
+
+static uint32_t cpu_share = CPU_SHARE_DENOMINATOR / 4;
+
+void spm_iovec_copy(void *dest, const void *src, size_t n)
+{
+    size_t cpu_bytes, dma_bytes;
+
+    if (n < tfm_hal_dma_copy_min_size()) {
+        memcpy(dest, src, n);
+        return;
+    }
+
+    /* Keep the split word aligned so that the CPU copy is not slowed down */
+    cpu_bytes = ((n / CPU_SHARE_DENOMINATOR) * cpu_share) & ~(size_t)0x3;
+    dma_bytes = n - cpu_bytes;
+
+    if (tfm_hal_dma_copy_start(dest, src, dma_bytes) != TFM_HAL_SUCCESS) {
+        memcpy(dest, src, n);
+        return;
+    }
+
+    /*
+     * Not spm_memcpy(), which a platform can route to the DMA that is
+     * already busy with the head of the copy.
+     */
+    memcpy((uint8_t *)dest + dma_bytes, (const uint8_t *)src + dma_bytes, cpu_bytes);
+
+    if (tfm_hal_dma_copy_is_done()) {
+        if (cpu_share > 0) {
+            cpu_share--;
+        }
+    } else if (cpu_share < CPU_SHARE_MAX) {
+        cpu_share++;
+    }
+
+    if (tfm_hal_dma_copy_wait() != TFM_HAL_SUCCESS) {
+        /* The copy can't fail from the caller's point of view */
+        tfm_core_panic();
+    }
+}
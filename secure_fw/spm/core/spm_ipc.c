@@ -41,6 +41,7 @@
 #include "load/spm_load_api.h"
 #include "tfm_nspm.h"
 #include "private/assert.h"
+#include "utilities.h"
 
 /* Partition and service runtime data list head/runtime data table */
 static struct service_head_t services_listhead;
@@ -345,7 +346,7 @@ void spm_init_idle_connection(struct connection_t *p_connection,
 
     p_connection->status = TFM_HANDLE_STATUS_IDLE;
 #if PSA_FRAMEWORK_HAS_MM_IOVEC
-    p_connection->iovec_status = 0;
+    spm_memset(p_connection->iovec_status, 0, sizeof(p_connection->iovec_status));
 #endif
 
 #ifdef TFM_PARTITION_NS_AGENT_MAILBOX
@@ -432,6 +433,9 @@ uint32_t tfm_spm_init(void)
         backend_init_comp_assuredly(partition, service_setting);
     }
 
+    /* The boundaries have changed */
+    spm_memory_check_cache_invalidate();
+
 #if CONFIG_TFM_POST_PARTITION_INIT_HOOK == 1
     /*
      * Platform can use CONFIG_TFM_POST_PARTITION_INIT_HOOK option to add extra initialization
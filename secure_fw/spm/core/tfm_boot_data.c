@@ -81,19 +81,44 @@ static const struct boot_data_access_policy access_policy_table[] = {
 #endif
 };
 
+#ifdef BOOT_DATA_AVAILABLE
+/*!
+ * \struct boot_data_span
+ *
+ * \brief Locates the TLVs of one major type in the shared data area.
+ */
+struct boot_data_span {
+    uintptr_t start;    /* Address of the first TLV of the major type */
+    uintptr_t end;      /* End address of the last TLV of the major type */
+    uint16_t len;       /* Total size of the TLVs of the major type */
+};
+
+/*!
+ * \var boot_data_index
+ *
+ * \brief The TLVs of the major type of each entry of access_policy_table, as
+ *        found when the shared data area is validated. The TLVs of a major
+ *        type are usually contiguous, in which case \ref boot_data_span.len is
+ *        equal to the distance between start and end, and they are copied
+ *        at once.
+ */
+static struct boot_data_span boot_data_index[ARRAY_SIZE(access_policy_table)];
+#endif /* BOOT_DATA_AVAILABLE */
+
 /*!
  * \brief Verify the access right of the active secure partition to the
  *        specified data type in the shared data area.
  *
  * \param[in]  major_type  Data type identifier.
  *
- * \return  Returns 0 in case of success, otherwise -1.
+ * \return  Returns the index of the entry of access_policy_table which grants
+ *          the access, or 0 if the access isn't granted.
  */
-static int32_t tfm_core_check_boot_data_access_policy(uint8_t major_type)
+static uint32_t tfm_core_check_boot_data_access_policy(uint8_t major_type)
 {
     int32_t partition_id;
     uint32_t i;
-    int32_t rc = -1;
+    uint32_t rc = 0;
     const uint32_t array_size = ARRAY_SIZE(access_policy_table);
 
     partition_id = tfm_spm_partition_get_running_partition_id();
@@ -106,7 +131,7 @@ static int32_t tfm_core_check_boot_data_access_policy(uint8_t major_type)
     for (i = 1; i < array_size; ++i) {
         if (partition_id == access_policy_table[i].partition_id) {
             if (major_type == access_policy_table[i].major_type) {
-                rc = 0;
+                rc = i;
                 break;
             }
         }
@@ -129,12 +154,52 @@ void tfm_core_validate_boot_data(void)
 {
 #ifdef BOOT_DATA_AVAILABLE
     struct tfm_boot_data *boot_data;
+    struct shared_data_tlv_entry tlv_entry;
+    uintptr_t tlv_end, offset;
+    size_t next_tlv_offset = 0;
+    uint32_t i;
 
     boot_data = (struct tfm_boot_data *)SHARED_BOOT_MEASUREMENT_BASE;
 
-    if (boot_data->header.tlv_magic == SHARED_DATA_TLV_INFO_MAGIC) {
-        is_boot_data_valid = BOOT_DATA_VALID;
+    if ((boot_data->header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) ||
+        (boot_data->header.tlv_tot_len < SHARED_DATA_HEADER_SIZE) ||
+        (boot_data->header.tlv_tot_len > SHARED_BOOT_MEASUREMENT_SIZE)) {
+        return;
     }
+
+    tlv_end = SHARED_BOOT_MEASUREMENT_BASE + boot_data->header.tlv_tot_len;
+    offset  = SHARED_BOOT_MEASUREMENT_BASE + SHARED_DATA_HEADER_SIZE;
+
+    /* Index the TLVs of each major type that partitions can access, so that
+     * the whole TLV section isn't iterated over on every request.
+     */
+    for (; offset < tlv_end; offset += next_tlv_offset) {
+        /* Create local copy to avoid unaligned access */
+        (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                         SHARED_DATA_ENTRY_HEADER_SIZE);
+
+        next_tlv_offset = SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
+
+        /* A TLV which runs past the end of the TLV section is corrupted */
+        if (next_tlv_offset > (tlv_end - offset)) {
+            return;
+        }
+
+        for (i = 1; i < ARRAY_SIZE(access_policy_table); i++) {
+            if (GET_MAJOR(tlv_entry.tlv_type) !=
+                access_policy_table[i].major_type) {
+                continue;
+            }
+
+            if (boot_data_index[i].len == 0) {
+                boot_data_index[i].start = offset;
+            }
+            boot_data_index[i].end = offset + next_tlv_offset;
+            boot_data_index[i].len += next_tlv_offset;
+        }
+    }
+
+    is_boot_data_valid = BOOT_DATA_VALID;
 #else
     is_boot_data_valid = BOOT_DATA_VALID;
 #endif /* BOOT_DATA_AVAILABLE */
@@ -146,10 +211,12 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
     uint8_t *buf_start = (uint8_t *)args[1];
     uint16_t buf_size  = (uint16_t)args[2];
     struct tfm_boot_data *boot_data;
+    uint32_t policy_idx;
 #ifdef BOOT_DATA_AVAILABLE
+    const struct boot_data_span *span;
     uint8_t *ptr;
     struct shared_data_tlv_entry tlv_entry;
-    uintptr_t tlv_end, offset;
+    uintptr_t offset;
     size_t next_tlv_offset = 0;
 #endif /* BOOT_DATA_AVAILABLE */
     const struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
@@ -169,18 +236,12 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
     }
 
     /* Check whether caller has access right to given tlv_major_type */
-    if (tfm_core_check_boot_data_access_policy(tlv_major)) {
+    policy_idx = tfm_core_check_boot_data_access_policy(tlv_major);
+    if (policy_idx == 0) {
         args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
         return;
     }
 
-#ifdef BOOT_DATA_AVAILABLE
-    /* Get the boundaries of TLV section */
-    boot_data = (struct tfm_boot_data *)SHARED_BOOT_MEASUREMENT_BASE;
-    tlv_end = SHARED_BOOT_MEASUREMENT_BASE + boot_data->header.tlv_tot_len;
-    offset  = SHARED_BOOT_MEASUREMENT_BASE + SHARED_DATA_HEADER_SIZE;
-#endif /* BOOT_DATA_AVAILABLE */
-
     /* Add header to output buffer as well */
     if (buf_size < SHARED_DATA_HEADER_SIZE) {
         args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
@@ -192,29 +253,38 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
     }
 
 #ifdef BOOT_DATA_AVAILABLE
+    span = &boot_data_index[policy_idx];
+
+    /* Check buffer overflow */
+    if (span->len > (buf_size - SHARED_DATA_HEADER_SIZE)) {
+        args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+        return;
+    }
+
     ptr = boot_data->data;
-    /* Iterates over the TLV section and copy TLVs with requested major
-     * type to the provided buffer.
-     */
-    for (; offset < tlv_end; offset += next_tlv_offset) {
-        /* Create local copy to avoid unaligned access */
-        (void)spm_memcpy(&tlv_entry, (const void *)offset,
-                         SHARED_DATA_ENTRY_HEADER_SIZE);
+    if (span->len == (span->end - span->start)) {
+        /* No TLV of another major type in between, copy them at once */
+        (void)spm_memcpy(ptr, (const void *)span->start, span->len);
+    } else {
+        /* Iterates over the TLVs between the first and the last ones of the
+         * requested major type, and copy those of that type to the provided
+         * buffer.
+         */
+        for (offset = span->start; offset < span->end;
+             offset += next_tlv_offset) {
+            /* Create local copy to avoid unaligned access */
+            (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                             SHARED_DATA_ENTRY_HEADER_SIZE);
 
-        next_tlv_offset = SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
+            next_tlv_offset = SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
 
-        if (GET_MAJOR(tlv_entry.tlv_type) == tlv_major) {
-            /* Check buffer overflow */
-            if (((ptr - buf_start) + next_tlv_offset) > buf_size) {
-                args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
-                return;
+            if (GET_MAJOR(tlv_entry.tlv_type) == tlv_major) {
+                (void)spm_memcpy(ptr, (const void *)offset, next_tlv_offset);
+                ptr += next_tlv_offset;
             }
-
-            (void)spm_memcpy(ptr, (const void *)offset, next_tlv_offset);
-            ptr += next_tlv_offset;
-            boot_data->header.tlv_tot_len += next_tlv_offset;
         }
     }
+    boot_data->header.tlv_tot_len += span->len;
 #endif /* BOOT_DATA_AVAILABLE */
 
     args[0] = (uint32_t)PSA_SUCCESS;
@@ -21,10 +21,11 @@
 
 /*
  * The MM-IOVEC status
- * The max total number of invec and outvec is 8.
- * Each invec/outvec takes 4 bit, 32 bits in total.
+ * Each invec/outvec takes 4 bits, eight vectors are packed in each 32-bit
+ * status word. With the default PSA_MAX_IOVEC of 4 the status is a single
+ * word.
  *
- * The encoding format of the MM-IOVEC status:
+ * The encoding format of the MM-IOVEC status, for PSA_MAX_IOVEC of 4:
  *--------------------------------------------------------------
  *|  Bit   |  31 - 28  |  27 - 24  | ... |  7 - 4   |  3 - 0   |
  *--------------------------------------------------------------
@@ -41,9 +42,13 @@
  */
 
 #define IOVEC_STATUS_BITS              4   /* Each vector occupies 4 bits. */
-#define OUTVEC_IDX_BASE                4   /*
+#define IOVEC_STATUS_PER_WORD          (32 / IOVEC_STATUS_BITS)
+#define IOVEC_STATUS_WORDS             \
+    (((PSA_MAX_IOVEC * 2) + IOVEC_STATUS_PER_WORD - 1) / IOVEC_STATUS_PER_WORD)
+#define OUTVEC_IDX_BASE                PSA_MAX_IOVEC
+                                           /*
                                             * Base index of outvec.
-                                            * There are four invecs in front of
+                                            * All the invecs are in front of
                                             * outvec.
                                             */
 #define INVEC_IDX_BASE                 0   /* Base index of invec. */
@@ -52,27 +57,32 @@
 #define IOVEC_UNMAPPED_BIT             (1UL << 1)
 #define IOVEC_ACCESSED_BIT             (1UL << 2)
 
+#define IOVEC_STATUS_WORD(handle, iovec_idx)    \
+    ((handle)->iovec_status[(iovec_idx) / IOVEC_STATUS_PER_WORD])
+#define IOVEC_STATUS_SHIFT(iovec_idx)           \
+    (((iovec_idx) % IOVEC_STATUS_PER_WORD) * IOVEC_STATUS_BITS)
+
 #define IOVEC_IS_MAPPED(handle, iovec_idx)      \
-    ((((handle)->iovec_status) >> ((iovec_idx) * IOVEC_STATUS_BITS)) &  \
+    ((IOVEC_STATUS_WORD(handle, iovec_idx) >> IOVEC_STATUS_SHIFT(iovec_idx)) & \
                                IOVEC_MAPPED_BIT)
 #define IOVEC_IS_UNMAPPED(handle, iovec_idx)    \
-    ((((handle)->iovec_status) >> ((iovec_idx) * IOVEC_STATUS_BITS)) &  \
+    ((IOVEC_STATUS_WORD(handle, iovec_idx) >> IOVEC_STATUS_SHIFT(iovec_idx)) & \
                                IOVEC_UNMAPPED_BIT)
 #define IOVEC_IS_ACCESSED(handle, iovec_idx)    \
-    ((((handle)->iovec_status) >> ((iovec_idx) * IOVEC_STATUS_BITS)) &  \
+    ((IOVEC_STATUS_WORD(handle, iovec_idx) >> IOVEC_STATUS_SHIFT(iovec_idx)) & \
                                IOVEC_ACCESSED_BIT)
 #define SET_IOVEC_ACCESSED(handle, iovec_idx)   \
-    (((handle)->iovec_status) |= (IOVEC_ACCESSED_BIT << \
-                              ((iovec_idx) * IOVEC_STATUS_BITS)))
+    (IOVEC_STATUS_WORD(handle, iovec_idx) |= (IOVEC_ACCESSED_BIT << \
+                              IOVEC_STATUS_SHIFT(iovec_idx)))
 #define SET_IOVEC_MAPPED(handle, iovec_idx) \
     do { \
-        ((handle)->iovec_status) |= (IOVEC_MAPPED_BIT << ((iovec_idx) * IOVEC_STATUS_BITS)); \
-        ((handle)->iovec_status) &= ~(IOVEC_UNMAPPED_BIT << ((iovec_idx) * IOVEC_STATUS_BITS)); \
+        IOVEC_STATUS_WORD(handle, iovec_idx) |= (IOVEC_MAPPED_BIT << IOVEC_STATUS_SHIFT(iovec_idx)); \
+        IOVEC_STATUS_WORD(handle, iovec_idx) &= ~(IOVEC_UNMAPPED_BIT << IOVEC_STATUS_SHIFT(iovec_idx)); \
     } while (0)
 #define SET_IOVEC_UNMAPPED(handle, iovec_idx) \
     do { \
-        ((handle)->iovec_status) |= (IOVEC_UNMAPPED_BIT << ((iovec_idx) * IOVEC_STATUS_BITS)); \
-        ((handle)->iovec_status) &= ~(IOVEC_MAPPED_BIT << ((iovec_idx) * IOVEC_STATUS_BITS)); \
+        IOVEC_STATUS_WORD(handle, iovec_idx) |= (IOVEC_UNMAPPED_BIT << IOVEC_STATUS_SHIFT(iovec_idx)); \
+        IOVEC_STATUS_WORD(handle, iovec_idx) &= ~(IOVEC_MAPPED_BIT << IOVEC_STATUS_SHIFT(iovec_idx)); \
     } while (0)
 
 #endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
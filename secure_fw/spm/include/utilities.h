@@ -16,6 +16,13 @@
  */
 void tfm_core_panic(void);
 
+/*
+ * Forget the memory ranges validated by the SPM. To be called by the platform
+ * whenever it changes the memory access rights, e.g. when reconfiguring the
+ * SAU or an MPC at runtime.
+ */
+void spm_memory_check_cache_invalidate(void);
+
 /* Get container structure start address from member */
 #define TO_CONTAINER(ptr, type, member) \
     ((type *)((unsigned long)(ptr) - offsetof(type, member)))
@@ -40,4 +47,11 @@ void *spm_memcpy(void *dest, const void *src, size_t n);
 void *spm_memset(void *s, int c, size_t n);
 #endif /* spm_memset */
 
+/* Copy between a client vector and a service buffer */
+#ifdef CONFIG_TFM_SPM_DMA_IOVEC_COPY
+void spm_iovec_copy(void *dest, const void *src, size_t n);
+#else
+#define spm_iovec_copy spm_memcpy
+#endif /* CONFIG_TFM_SPM_DMA_IOVEC_COPY */
+
 #endif /* __TFM_UTILS_H__ */
@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "tfm_hal_device_header.h"
+#include "memory_check_cache.h"
 #include "tfm_ns_ctx.h"
 #include "tfm_nspm.h"
 
@@ -19,6 +20,23 @@ static struct tfm_ns_ctx_t ns_ctx_data[TFM_NS_CONTEXT_MAX] = {0};
 /* Current active NS context index. Default is invalid index */
 static uint8_t active_ns_ctx_index = TFM_NS_CONTEXT_MAX;
 
+/*
+ * Index of the context in use by each group ID, or TFM_NS_CONTEXT_MAX if the
+ * group has none, so that a group finds its context without a search.
+ */
+static uint8_t ns_ctx_of_group[UINT8_MAX + 1];
+
+/* First context of the list of free contexts, linked through next_free */
+static uint8_t ns_ctx_free_head = TFM_NS_CONTEXT_MAX;
+
+/* Returns a context whose last thread has released it to the free list */
+static void free_ns_ctx(uint8_t idx)
+{
+    ns_ctx_of_group[ns_ctx_data[idx].gid] = TFM_NS_CONTEXT_MAX;
+    ns_ctx_data[idx].next_free = ns_ctx_free_head;
+    ns_ctx_free_head = idx;
+}
+
 bool init_ns_ctx(void)
 {
     uint32_t i;
@@ -26,6 +44,12 @@ bool init_ns_ctx(void)
     for (i = 0; i < TFM_NS_CONTEXT_MAX; i++) {
         /* Only need to ensure the reference counter is 0 */
         ns_ctx_data[i].ref_cnt = 0;
+        ns_ctx_data[i].next_free = (uint8_t)(i + 1);
+    }
+    ns_ctx_free_head = 0;
+
+    for (i = 0; i <= UINT8_MAX; i++) {
+        ns_ctx_of_group[i] = TFM_NS_CONTEXT_MAX;
     }
 
     active_ns_ctx_index = TFM_NS_CONTEXT_MAX;
@@ -34,57 +58,43 @@ bool init_ns_ctx(void)
 
 bool acquire_ns_ctx(uint8_t gid, uint8_t *idx)
 {
-    /* Only support one context slot for now */
-    uint32_t i;
-    uint32_t empty_ctx_idx = TFM_NS_CONTEXT_MAX; /* default is invalid */
+    uint8_t ctx_idx;
 
     __disable_irq();
-    /*
-     * Go through all context slots to get the context for the given group ID.
-     * It will not take a long time as the context number should be limited.
-     */
-    for (i = 0; i < TFM_NS_CONTEXT_MAX; i++) {
-        if (ns_ctx_data[i].ref_cnt > 0) {  /* This context has been taken */
-            if (ns_ctx_data[i].gid == gid) {
-                /*
-                 * Found the context associated with the input group ID.
-                 * Check if the thread number reached the limit.
-                 */
-                if (ns_ctx_data[i].ref_cnt < TFM_NS_CONTEXT_MAX_TID) {
-                    /* Reuse this context and increase the reference number */
-                    ns_ctx_data[i].ref_cnt++;
-                    *idx = i;
-                    __enable_irq();
-                    return true;
-                } else {
-                    /* No more thread for this group */
-                    __enable_irq();
-                    return false;
-                }
-            }
-        } else {    /* Found an empty context slot */
-            /* Save the first unused context index and continue */
-            if (empty_ctx_idx == TFM_NS_CONTEXT_MAX) {
-                empty_ctx_idx = i;
-            }
-            /*
-             * Still need to go through the remaining slots to check if there
-             * is an existing context assigned to the given group ID.
-             */
+
+    ctx_idx = ns_ctx_of_group[gid];
+    if (ctx_idx < TFM_NS_CONTEXT_MAX) {
+        /*
+         * Found the context associated with the input group ID.
+         * Check if the thread number reached the limit.
+         */
+        if (ns_ctx_data[ctx_idx].ref_cnt < TFM_NS_CONTEXT_MAX_TID) {
+            /* Reuse this context and increase the reference number */
+            ns_ctx_data[ctx_idx].ref_cnt++;
+            *idx = ctx_idx;
+            __enable_irq();
+            return true;
+        } else {
+            /* No more thread for this group */
+            __enable_irq();
+            return false;
         }
     }
 
-    /* No existing context for the group ID, use the first free context */
-    if (empty_ctx_idx < TFM_NS_CONTEXT_MAX) {
-        ns_ctx_data[empty_ctx_idx].ref_cnt++;
-        ns_ctx_data[empty_ctx_idx].gid = gid;
-        *idx = empty_ctx_idx;
-        __enable_irq();
-        return true;
-    } else {
+    /* No existing context for the group ID, take the first free context */
+    ctx_idx = ns_ctx_free_head;
+    if (ctx_idx >= TFM_NS_CONTEXT_MAX) {
         __enable_irq();
         return false;   /* No available context */
     }
+
+    ns_ctx_free_head = ns_ctx_data[ctx_idx].next_free;
+    ns_ctx_data[ctx_idx].ref_cnt = 1;
+    ns_ctx_data[ctx_idx].gid = gid;
+    ns_ctx_of_group[gid] = ctx_idx;
+    *idx = ctx_idx;
+    __enable_irq();
+    return true;
 }
 
 bool release_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
@@ -96,8 +106,8 @@ bool release_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
 
     __disable_irq();
 
-    /* Check if the context belongs to that group  */
-    if (ns_ctx_data[idx].gid != gid) {
+    /* Check if the context belongs to that group and is in use */
+    if ((ns_ctx_data[idx].gid != gid) || (ns_ctx_data[idx].ref_cnt == 0)) {
         __enable_irq();
         return false;
     }
@@ -110,9 +120,7 @@ bool release_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
     if (idx == active_ns_ctx_index) {
         if (ns_ctx_data[idx].tid == tid) {
             /* Release the current active thread */
-            if (ns_ctx_data[idx].ref_cnt > 0) {
-                ns_ctx_data[idx].ref_cnt--;
-            }
+            ns_ctx_data[idx].ref_cnt--;
             active_ns_ctx_index = TFM_NS_CONTEXT_MAX;
         } else {
             /*
@@ -126,9 +134,12 @@ bool release_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
         }
     } else {
         /* Release in the non-active context */
-        if (ns_ctx_data[idx].ref_cnt > 0) {
-            ns_ctx_data[idx].ref_cnt--;
-        }
+        ns_ctx_data[idx].ref_cnt--;
+    }
+
+    /* The context is free once all the threads of the group released it */
+    if (ns_ctx_data[idx].ref_cnt == 0) {
+        free_ns_ctx(idx);
     }
 
     __enable_irq();
@@ -154,6 +165,9 @@ bool load_ns_ctx(uint8_t gid, uint8_t tid, int32_t nsid, uint8_t idx)
     ns_ctx_data[idx].nsid = nsid;
     active_ns_ctx_index = idx;
     __enable_irq();
+
+    /* The NS memory access rights may have changed with the NS thread */
+    spm_memory_check_cache_invalidate_ns();
     return true;
 }
 
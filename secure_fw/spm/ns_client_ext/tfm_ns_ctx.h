@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,9 +9,17 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "config_tfm.h"
 
-/* Supported maximum context for NS. Only support single context for now. */
-#define TFM_NS_CONTEXT_MAX                  1
+/*
+ * Supported maximum context for NS. The context index is 8 bits wide in the
+ * client token and TFM_NS_CONTEXT_MAX itself marks an invalid index.
+ */
+#define TFM_NS_CONTEXT_MAX                  CONFIG_TFM_NS_CONTEXT_MAX
+
+#if (TFM_NS_CONTEXT_MAX < 1) || (TFM_NS_CONTEXT_MAX > 255)
+#error "CONFIG_TFM_NS_CONTEXT_MAX must be between 1 and 255"
+#endif
 
 #define TFM_NS_CONTEXT_MAX_TID              0xFF
 
@@ -21,6 +29,7 @@ struct tfm_ns_ctx_t {
     uint8_t gid;        /* Group ID. Threads in same group share one context */
     uint8_t tid;        /* Thread ID. Used to identify threads in same group */
     uint8_t ref_cnt;    /* The number of threads sharing this context */
+    uint8_t next_free;  /* Next free context, while this one is free */
 };
 
 /* Initialize the non-secure context */
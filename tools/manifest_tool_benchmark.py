@@ -0,0 +1,190 @@
+#-------------------------------------------------------------------------------
+# SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Times the manifest tool on a synthetic list of Secure Partitions.
+
+Each partition has 3 services, an MMIO region and a dependency on a service of
+the previous partition. The tool is run:
+  - with an empty output directory,
+  - again with nothing changed,
+  - after changing a single manifest.
+The best time of several runs is reported for each case, as well as the number
+of generated files which were rewritten after changing a single manifest.
+"""
+
+import os
+import sys
+import json
+import time
+import shutil
+import argparse
+import tempfile
+import subprocess
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+MANIFEST_TOOL = os.path.join(TOOLS_DIR, 'tfm_parse_manifest_list.py')
+GENERATED_FILE_LIST = os.path.join(TOOLS_DIR, 'tfm_generated_file_list.yaml')
+
+SERVICES_PER_PARTITION = 3
+FIRST_PID = 300
+FIRST_SID = 0x1000
+
+def partition_manifest(idx, stack_size):
+    """
+    Manifest of the idx-th benchmark partition
+    """
+    services = []
+    for srv in range(SERVICES_PER_PARTITION):
+        services.append({
+            'name': 'BENCH_{}_SERVICE_{}'.format(idx, srv),
+            'sid': '0x{:08X}'.format(FIRST_SID + idx * SERVICES_PER_PARTITION + srv),
+            'non_secure_clients': True,
+            'connection_based': True,
+            'version': 1,
+            'version_policy': 'STRICT'
+        })
+
+    return {
+        'psa_framework_version': 1.1,
+        'name': 'TFM_SP_BENCH_{}'.format(idx),
+        'type': 'APPLICATION-ROT',
+        'priority': 'NORMAL',
+        'model': 'SFN',
+        'entry_init': 'bench_{}_init'.format(idx),
+        'stack_size': stack_size,
+        'services': services,
+        'mmio_regions': [{'name': 'BENCH_MMIO_{}'.format(idx),
+                          'permission': 'READ-WRITE'}],
+        'dependencies': ['BENCH_{}_SERVICE_0'.format(idx - 1)] if idx > 0 else []
+    }
+
+def write_json(path, data):
+    """
+    JSON is a subset of YAML, and is much faster to write
+    """
+    with open(path, 'w') as f:
+        json.dump(data, f, indent=2)
+
+def generate_inputs(work_dir, partition_count):
+    """
+    Write the manifests, the manifest list and the configuration header.
+    Returns the paths to the manifest list and to the configuration header.
+    """
+    parts_dir = os.path.join(work_dir, 'parts')
+    os.makedirs(parts_dir, exist_ok=True)
+
+    manifest_list = []
+    for idx in range(partition_count):
+        write_json(os.path.join(parts_dir, 'bench_{}.yaml'.format(idx)),
+                   partition_manifest(idx, '0x400'))
+        manifest_list.append({
+            'description': 'Bench partition {}'.format(idx),
+            'manifest': 'parts/bench_{}.yaml'.format(idx),
+            'output_path': 'secure_fw/partitions/bench_{}'.format(idx),
+            'version_major': 0,
+            'version_minor': 1,
+            'pid': FIRST_PID + idx,
+            'linker_pattern': {'library_list': ['*bench_{}*'.format(idx)]}
+        })
+
+    list_path = os.path.join(work_dir, 'bench_manifest_list.yaml')
+    write_json(list_path, {
+        'description': 'Manifest tool benchmark',
+        'type': 'manifest_list',
+        'version_major': 0,
+        'version_minor': 1,
+        'manifest_list': manifest_list
+    })
+
+    config_path = os.path.join(work_dir, 'manifest_config.h')
+    with open(config_path, 'w') as f:
+        f.write('#define TFM_ISOLATION_LEVEL 1\n')
+        f.write('#define CONFIG_TFM_SPM_BACKEND SFN\n')
+
+    return list_path, config_path
+
+def run_tool(list_path, config_path, out_dir):
+    """
+    Run the manifest tool once, returns the time it took in seconds
+    """
+    start = time.perf_counter()
+    subprocess.run([sys.executable, MANIFEST_TOOL,
+                    '-m', list_path,
+                    '-f', GENERATED_FILE_LIST,
+                    '-c', config_path,
+                    '-o', out_dir,
+                    '-q'],
+                   check=True, cwd=TOOLS_DIR)
+    return time.perf_counter() - start
+
+def file_times(out_dir):
+    """
+    Modification times of all the generated files
+    """
+    times = {}
+    for root, _, files in os.walk(out_dir):
+        for name in files:
+            # Skip the digests kept by the manifest tool
+            if name.startswith('.'):
+                continue
+            path = os.path.join(root, name)
+            times[path] = os.stat(path).st_mtime_ns
+    return times
+
+def main():
+    parser = argparse.ArgumentParser(description='Time the manifest tool on a '
+                                                 'synthetic list of partitions')
+    parser.add_argument('-n', '--partitions', type=int, default=64,
+                        help='Number of partitions to generate (default: 64)')
+    parser.add_argument('-r', '--runs', type=int, default=5,
+                        help='Runs of each case, the best is reported (default: 5)')
+    parser.add_argument('-w', '--work-dir',
+                        help='Directory to keep the inputs and outputs in, '
+                             'a temporary one is used by default')
+    args = parser.parse_args()
+
+    tmp_dir = None
+    if args.work_dir:
+        work_dir = os.path.abspath(args.work_dir)
+        os.makedirs(work_dir, exist_ok=True)
+    else:
+        tmp_dir = tempfile.TemporaryDirectory()
+        work_dir = tmp_dir.name
+
+    list_path, config_path = generate_inputs(work_dir, args.partitions)
+    out_dir = os.path.join(work_dir, 'generated')
+
+    cold = []
+    for _ in range(args.runs):
+        shutil.rmtree(out_dir, ignore_errors=True)
+        cold.append(run_tool(list_path, config_path, out_dir))
+
+    warm = [run_tool(list_path, config_path, out_dir) for _ in range(args.runs)]
+
+    changed = []
+    manifest_path = os.path.join(work_dir, 'parts', 'bench_0.yaml')
+    for run in range(args.runs):
+        # A different stack size on each run, so that every run sees a change
+        write_json(manifest_path, partition_manifest(0, '0x{:X}'.format(0x500 + run * 0x100)))
+        before = file_times(out_dir)
+        changed.append(run_tool(list_path, config_path, out_dir))
+        after = file_times(out_dir)
+    rewritten = sum(1 for path in after if before.get(path) != after[path])
+
+    print('{} partitions, {} generated files, best of {} runs:'
+          .format(args.partitions, len(after), args.runs))
+    print('  empty output directory: {:6.3f} s'.format(min(cold)))
+    print('  nothing changed:        {:6.3f} s'.format(min(warm)))
+    print('  one manifest changed:   {:6.3f} s ({} files rewritten)'
+          .format(min(changed), rewritten))
+
+    if tmp_dir:
+        tmp_dir.cleanup()
+
+if __name__ == '__main__':
+    main()
@@ -11,6 +11,8 @@ import os
 import io
 import re
 import sys
+import json
+import hashlib
 import argparse
 import logging
 from jinja2 import Environment, BaseLoader, select_autoescape, TemplateNotFound
@@ -22,12 +24,25 @@ except ImportError as e:
     logging.error ("pip install PyYAML")
     exit(1)
 
+# The LibYAML based loader is an order of magnitude faster than the pure Python
+# one, use it when PyYAML has been built with it.
+try:
+    from yaml import CSafeLoader as YamlLoader
+except ImportError:
+    from yaml import SafeLoader as YamlLoader
+
 donotedit_warning = \
                     '  WARNING: This is an auto-generated file. Do not edit!  '
 
 TFM_ROOT_DIR = os.path.join(sys.path[0], '..')
 OUT_DIR = None # The root directory that files are generated to
 
+# Records a digest of the inputs of each generated file, see render_file()
+RENDER_CACHE_FILE = '.manifest_tool_cache.json'
+RENDER_CACHE = {}
+TEMPLATES = {}
+SCRIPT_DIGEST = b''
+
 # PID[0, TFM_PID_BASE - 1] are reserved for TF-M SPM and test usages
 TFM_PID_BASE = 256
 
@@ -71,7 +86,7 @@ class TemplateLoader(BaseLoader):
         http://jinja.pocoo.org/docs/2.10/api/#jinja2.BaseLoader.get_source
 
         Please note that this function always return 'false' as 'uptodate'
-        value, so the output file will always be generated.
+        value, so each template must only be loaded once. See render_file().
         """
         if not os.path.isfile(template):
             raise TemplateNotFound(template)
@@ -349,7 +364,7 @@ def process_partition_manifests(manifest_lists, configs):
 
         # The manifest list file generated by configure_file()
         with open(item) as manifest_list_yaml_file:
-            manifest_dic = yaml.safe_load(manifest_list_yaml_file)['manifest_list']
+            manifest_dic = yaml.load(manifest_list_yaml_file, Loader=YamlLoader)['manifest_list']
             for dict in manifest_dic:
                 # Replace environment variables in the manifest path.
                 expanded_path = os.path.expandvars(dict['manifest']).replace('\\', '/')
@@ -410,7 +425,7 @@ def process_partition_manifests(manifest_lists, configs):
 
         manifest_path = manifest_item['manifest']
         with open(manifest_path) as manifest_file:
-            manifest = yaml.safe_load(manifest_file)
+            manifest = yaml.load(manifest_file, Loader=YamlLoader)
             # Check manifest attribute validity
             manifest_attribute_check(manifest, manifest_item)
 
@@ -534,6 +549,73 @@ def process_partition_manifests(manifest_lists, configs):
 
     return context
 
+def load_render_cache():
+    """
+    Load the digests of the files generated by the previous run, if any
+    """
+    global RENDER_CACHE, SCRIPT_DIGEST
+
+    # The digest of this script is part of every file digest, so that changes
+    # to the way files are generated invalidate all of them
+    with open(os.path.abspath(__file__), 'rb') as f:
+        SCRIPT_DIGEST = hashlib.sha256(f.read()).digest()
+
+    try:
+        with open(os.path.join(OUT_DIR, RENDER_CACHE_FILE)) as f:
+            RENDER_CACHE = json.load(f)
+    except (OSError, ValueError):
+        RENDER_CACHE = {}
+
+def save_render_cache():
+    """
+    Save the digests of the files generated by this run
+    """
+    write_file_if_changed(os.path.join(OUT_DIR, RENDER_CACHE_FILE),
+                          json.dumps(RENDER_CACHE, indent=1, sort_keys=True))
+
+def write_file_if_changed(out_file, content):
+    """
+    Write content to out_file, unless the file already has this content.
+    Leaving unchanged files untouched keeps their timestamps, so that the
+    build system doesn't rebuild what depends on them.
+    """
+    if os.path.isfile(out_file):
+        with io.open(out_file, 'r', newline=None) as f:
+            if f.read() == content:
+                return
+
+    outfile_path = os.path.dirname(out_file)
+    if not os.path.exists(outfile_path):
+        os.makedirs(outfile_path)
+
+    with io.open(out_file, 'w', newline=None) as f:
+        f.write(content)
+
+def render_file(template_file, context, out_file):
+    """
+    Render a template into out_file.
+
+    The output is fully determined by the template, the context and this
+    script, so it is only rendered if the digest of those differs from the one
+    recorded when out_file was last generated.
+    """
+    with open(template_file, 'rb') as f:
+        template_source = f.read()
+
+    digest = hashlib.sha256(SCRIPT_DIGEST + template_source +
+                            repr(context).encode()).hexdigest()
+
+    if RENDER_CACHE.get(out_file) == digest and os.path.isfile(out_file):
+        return
+
+    # The templates are compiled on first use only, the template loader
+    # doesn't support the template cache of the environment.
+    if template_file not in TEMPLATES:
+        TEMPLATES[template_file] = ENV.get_template(template_file)
+
+    write_file_if_changed(out_file, TEMPLATES[template_file].render(context))
+    RENDER_CACHE[out_file] = digest
+
 def gen_per_partition_files(context):
     """
     Generate per-partition files
@@ -548,9 +630,9 @@ def gen_per_partition_files(context):
     partition_context['utilities'] = context['utilities']
     partition_context['config_impl'] = context['config_impl']
 
-    manifesttemplate = ENV.get_template(os.path.join(sys.path[0], 'templates/manifestfilename.template'))
-    memorytemplate = ENV.get_template(os.path.join(sys.path[0], 'templates/partition_intermedia.template'))
-    infotemplate = ENV.get_template(os.path.join(sys.path[0], 'templates/partition_load_info.template'))
+    manifesttemplate = os.path.join(sys.path[0], 'templates/manifestfilename.template')
+    memorytemplate = os.path.join(sys.path[0], 'templates/partition_intermedia.template')
+    infotemplate = os.path.join(sys.path[0], 'templates/partition_load_info.template')
 
     logging.info ("Start to generate partition files:")
 
@@ -562,27 +644,9 @@ def gen_per_partition_files(context):
 
         logging.info ('Generating {} in {}'.format(one_partition['attr']['description'],
                                             one_partition['output_dir']))
-        outfile_path = os.path.dirname(one_partition['header_file'])
-        if not os.path.exists(outfile_path):
-            os.makedirs(outfile_path)
-
-        headerfile = io.open(one_partition['header_file'], 'w', newline=None)
-        headerfile.write(manifesttemplate.render(partition_context))
-        headerfile.close()
-
-        intermediafile_path = os.path.dirname(one_partition['intermedia_file'])
-        if not os.path.exists(intermediafile_path):
-            os.makedirs(intermediafile_path)
-        intermediafile = io.open(one_partition['intermedia_file'], 'w', newline=None)
-        intermediafile.write(memorytemplate.render(partition_context))
-        intermediafile.close()
-
-        infofile_path = os.path.dirname(one_partition['loadinfo_file'])
-        if not os.path.exists(infofile_path):
-            os.makedirs(infofile_path)
-        infooutfile = io.open(one_partition['loadinfo_file'], 'w', newline=None)
-        infooutfile.write(infotemplate.render(partition_context))
-        infooutfile.close()
+        render_file(manifesttemplate, partition_context, one_partition['header_file'])
+        render_file(memorytemplate, partition_context, one_partition['intermedia_file'])
+        render_file(infotemplate, partition_context, one_partition['loadinfo_file'])
 
     logging.info ("Per-partition files done:")
 
@@ -599,7 +663,7 @@ def gen_summary_files(context, gen_file_lists):
 
     for f in gen_file_lists:
         with open(f) as file_list_yaml_file:
-            file_list_yaml = yaml.safe_load(file_list_yaml_file)
+            file_list_yaml = yaml.load(file_list_yaml_file, Loader=YamlLoader)
             file_list.extend(file_list_yaml['file_list'])
 
     for file in file_list:
@@ -610,15 +674,7 @@ def gen_summary_files(context, gen_file_lists):
 
         manifest_out_file = os.path.join(OUT_DIR, manifest_out_file)
 
-        outfile_path = os.path.dirname(manifest_out_file)
-        if not os.path.exists(outfile_path):
-            os.makedirs(outfile_path)
-
-        template = ENV.get_template(templatefile_name)
-
-        outfile = io.open(manifest_out_file, 'w', newline=None)
-        outfile.write(template.render(context))
-        outfile.close()
+        render_file(templatefile_name, context, manifest_out_file)
 
 def process_stateless_services(partitions):
     """
@@ -808,8 +864,10 @@ def main():
 
     context['utilities'] = utilities
 
+    load_render_cache()
     gen_per_partition_files(context)
     gen_summary_files(context, gen_file_lists)
+    save_render_cache()
 
 if __name__ == '__main__':
     main()